@@ -0,0 +1,139 @@
+/*
+   ====================================================================
+   Arena Allocator Implementation
+   --------------------------------------------------------------------
+   Blocks are chained and carved with a bump pointer. A reset only
+   rewinds to the first block; later blocks are rewound lazily when the
+   bump pointer reaches them again, so the reset itself is O(1).
+   ====================================================================
+*/
+
+#include <string.h>
+#include "arena.h"
+
+/* Global arenas */
+_Thread_local Arena compilationArena = { NULL, NULL, 0 };
+Arena grammarArena = { NULL, NULL, 0 };
+
+// ------------------------- ARENA IMPLEMENTATION -------------------------
+
+static ArenaBlock* newArenaBlock(size_t size) {
+    /*
+       Allocates a block with at least the given number of usable bytes.
+    */
+    ArenaBlock* block = (ArenaBlock*) malloc(sizeof(ArenaBlock) + size);
+    if (!block) {
+        fprintf(stderr, "Memory allocation failed for arena block\n");
+        exit(EXIT_FAILURE);
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+void* arenaAlloc(Arena* arena, size_t bytes) {
+    /*
+       Carves the requested number of bytes from the current block.
+       When it does not fit, moves on to the next block of the chain
+       (rewinding it, since it may hold data from before a reset) or
+       appends a new block sized for the request.
+    */
+    bytes = (bytes + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+    if (!arena->current) {
+        arena->first = newArenaBlock(bytes > ARENA_BLOCK_SZ ? bytes : ARENA_BLOCK_SZ);
+        arena->current = arena->first;
+    }
+
+    while (arena->current->used + bytes > arena->current->size) {
+        ArenaBlock* next = arena->current->next;
+        if (!next) {
+            next = newArenaBlock(bytes > ARENA_BLOCK_SZ ? bytes : ARENA_BLOCK_SZ);
+            arena->current->next = next;
+        }
+        next->used = 0;
+        arena->current = next;
+    }
+
+    void* mem = arena->current->data + arena->current->used;
+    arena->current->used += bytes;
+    return mem;
+}
+
+void* arenaCalloc(Arena* arena, size_t bytes) {
+    /*
+       Same as arenaAlloc, but zeroes the memory since reused blocks are dirty.
+    */
+    void* mem = arenaAlloc(arena, bytes);
+    memset(mem, 0, bytes);
+    return mem;
+}
+
+void resetArena(Arena* arena) {
+    /*
+       Releases every allocation at once. Pools notice the new epoch and
+       drop their free lists the next time they are used.
+    */
+    arena->current = arena->first;
+    if (arena->first)
+        arena->first->used = 0;
+    arena->epoch++;
+}
+
+void destroyArena(Arena* arena) {
+    /*
+       Frees the whole block chain.
+    */
+    ArenaBlock* block = arena->first;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->epoch++;
+}
+
+// ------------------------- SLAB POOL IMPLEMENTATION -------------------------
+
+static Arena* poolArena(SlabPool* pool) {
+    /*
+       Resolves the arena of a pool; the address of a thread-local arena
+       cannot appear in a static initializer, so those pools store NULL.
+    */
+    return pool->arena ? pool->arena : &compilationArena;
+}
+
+void* poolAlloc(SlabPool* pool) {
+    /*
+       Reuses a released item when one is available, otherwise carves a new one.
+       A free list left over from before an arena reset is discarded.
+    */
+    Arena* arena = poolArena(pool);
+    if (pool->epoch != arena->epoch) {
+        pool->freeList = NULL;
+        pool->epoch = arena->epoch;
+    }
+    if (pool->freeList) {
+        void* item = pool->freeList;
+        pool->freeList = *(void**) item;
+        return item;
+    }
+    return arenaAlloc(arena, pool->itemSize);
+}
+
+void poolFree(SlabPool* pool, void* item) {
+    /*
+       Pushes the item onto the pool's free list.
+    */
+    if (!item) return;
+    Arena* arena = poolArena(pool);
+    if (pool->epoch != arena->epoch) {
+        pool->freeList = NULL;
+        pool->epoch = arena->epoch;
+    }
+    *(void**) item = pool->freeList;
+    pool->freeList = item;
+}
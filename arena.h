@@ -0,0 +1,78 @@
+/*
+   ====================================================================
+   Arena Allocator - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   Bump-pointer arenas for objects that share a lifetime, and typed
+   slab pools on top of them for fixed-size structures that are
+   recycled while the arena is live. Resetting an arena releases
+   everything allocated from it in O(1); its blocks are kept and
+   reused by the next compilation.
+   ====================================================================
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Constant Definitions */
+#define ARENA_BLOCK_SZ     (64 * 1024)   // Usable bytes in a regular arena block
+#define ARENA_ALIGN        8             // Alignment of every arena allocation
+
+// ArenaBlock: One contiguous chunk of arena memory.
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;   // Next block in the chain
+    size_t size;               // Usable bytes in data
+    size_t used;               // Bytes handed out from data so far
+    _Alignas(ARENA_ALIGN) char data[];  // Backing storage
+} ArenaBlock;
+
+// Arena: A chain of blocks carved sequentially.
+typedef struct Arena {
+    ArenaBlock* first;         // First block, kept across resets
+    ArenaBlock* current;       // Block allocations are currently carved from
+    unsigned long epoch;       // Incremented on every reset
+} Arena;
+
+// SlabPool: Free-list of fixed-size items carved from an arena.
+typedef struct SlabPool {
+    Arena* arena;              // Arena the items come from; NULL for the calling thread's compilationArena
+    size_t itemSize;           // Size of one item
+    void* freeList;            // Items released back to the pool
+    unsigned long epoch;       // Arena epoch the free list belongs to
+} SlabPool;
+
+// Arena holding objects that live for one compilation (tokens, symbols, parse tree).
+// Each thread has its own, so that files can be lexed in parallel.
+extern _Thread_local Arena compilationArena;
+
+// Arena holding the grammar, FIRST/FOLLOW sets and parse table for the whole process.
+extern Arena grammarArena;
+
+/* ----------- Arena Functions ----------- */
+// Allocate uninitialized memory from the arena.
+void* arenaAlloc(Arena* arena, size_t bytes);
+
+// Allocate zero-initialized memory from the arena.
+void* arenaCalloc(Arena* arena, size_t bytes);
+
+// Release everything allocated from the arena, keeping its blocks for reuse.
+void resetArena(Arena* arena);
+
+// Return all blocks of the arena to the system.
+void destroyArena(Arena* arena);
+
+/* ----------- Slab Pool Functions ----------- */
+// Take one item from the pool.
+void* poolAlloc(SlabPool* pool);
+
+// Give an item back to the pool.
+void poolFree(SlabPool* pool, void* item);
+
+// Declare a pool of items of the given type drawn from the given arena.
+#define SLAB_POOL(type, arenaPtr) { (arenaPtr), sizeof(type) < sizeof(void*) ? sizeof(void*) : sizeof(type), NULL, 0 }
+
+#endif
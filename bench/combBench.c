@@ -0,0 +1,152 @@
+/*
+   ====================================================================
+   Comb-Vector Parse Table Benchmark
+   --------------------------------------------------------------------
+   Builds the LL(1) table of grammar.txt and of synthetic grammars of
+   the given sizes in the "keyword" and "random" shapes of
+   syntheticGrammar.h (conflicting cells keep the last rule, as
+   addRulesToParseTable() does), compresses each with
+   and without row defaults, and compares size and lookup time with
+   the dense table. Lookups follow a fixed random sequence of cells;
+   every compressed lookup is checked against the dense one.
+
+   Usage: combBench [rule count]... [-n lookups]
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "parserDef.h"
+#include "firstFollow.h"
+#include "combTable.h"
+#include "syntheticGrammar.h"
+
+#define DEFAULT_LOOKUPS  (1 << 22)
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static RuleIndex* buildDenseTable(const FlatGrammar* g) {
+    TokenSet* first = (TokenSet*) malloc(g->nonTerminals * sizeof(TokenSet));
+    TokenSet* follow = (TokenSet*) malloc(g->nonTerminals * sizeof(TokenSet));
+    RuleIndex* dense = (RuleIndex*) calloc((size_t) g->nonTerminals * TK_NOT_FOUND, sizeof(RuleIndex));
+    solveFirstFollow(g, first, follow);
+    for (int r = 0; r < g->ruleCount; r++) {
+        int lhs = CODE_TO_NT(g->ruleLhs[r]);
+        TokenSet f = firstOfSequence(g, first, g->ruleStart[r], g->ruleStart[r + 1]);
+        TokenSet predict = f & ~TOKEN_BIT(EPS);
+        if (IN_TOKEN_SET(f, EPS))
+            predict |= follow[lhs];
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++)
+            if (IN_TOKEN_SET(predict, tk))
+                dense[(size_t) lhs * TK_NOT_FOUND + tk] = (RuleIndex)(r + 1);
+    }
+    free(first);
+    free(follow);
+    return dense;
+}
+
+static void report(const char* name, int rules, const RuleIndex* dense, int rows, int lookups) {
+    // Random cells, fixed before timing
+    uint32_t* cells = (uint32_t*) malloc(lookups * sizeof(uint32_t));
+    for (int i = 0; i < lookups; i++)
+        cells[i] = ((nextRandom() % rows) << 8) | (nextRandom() % TK_NOT_FOUND);
+    int used = 0;
+    for (int i = 0; i < rows * TK_NOT_FOUND; i++)
+        used += dense[i] != NO_RULE;
+
+    // The sums keep the lookups from being optimized away; the first pass warms the caches
+    uint64_t denseSum = 0;
+    for (int i = 0; i < lookups; i++)
+        denseSum += dense[(cells[i] >> 8) * TK_NOT_FOUND + (cells[i] & 0xFF)];
+    double start = now();
+    denseSum = 0;
+    for (int i = 0; i < lookups; i++)
+        denseSum += dense[(cells[i] >> 8) * TK_NOT_FOUND + (cells[i] & 0xFF)];
+    double denseNs = (now() - start) / lookups * 1e9;
+    size_t denseBytes = (size_t) rows * TK_NOT_FOUND * sizeof(RuleIndex);
+    printf("%-10s %6d %6d %7.1f%% %-9s %10zu %8s %8.2f\n", name, rules, rows,
+           100.0 * used / (rows * TK_NOT_FOUND), "dense", denseBytes, "-", denseNs);
+
+    for (int withDefaults = 0; withDefaults <= 1; withDefaults++) {
+        CombTable comb;
+        double buildStart = now();
+        if (!buildCombTable(&comb, dense, rows, TK_NOT_FOUND, withDefaults))
+            break;
+        double buildMs = (now() - buildStart) * 1e3;
+
+        uint64_t combSum = 0;
+        for (int i = 0; i < lookups; i++)
+            combSum += combLookup(&comb, cells[i] >> 8, cells[i] & 0xFF);
+        start = now();
+        combSum = 0;
+        for (int i = 0; i < lookups; i++)
+            combSum += combLookup(&comb, cells[i] >> 8, cells[i] & 0xFF);
+        double combNs = (now() - start) / lookups * 1e9;
+
+        // Exact without defaults; with them only non-error cells must agree
+        int wrong = 0;
+        for (int r = 0; r < rows; r++)
+            for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+                RuleIndex expected = dense[r * TK_NOT_FOUND + tk];
+                if ((withDefaults ? expected != NO_RULE : true) && combLookup(&comb, r, tk) != expected)
+                    wrong++;
+            }
+        printf("%-10s %6s %6s %8s %-9s %10zu %7.1f%% %8.2f   built in %.2f ms%s\n", "", "", "", "",
+               withDefaults ? "defaults" : "comb", combTableBytes(&comb),
+               100.0 * combTableBytes(&comb) / denseBytes, combNs, buildMs,
+               wrong ? "  MISMATCH" : "");
+        if (!withDefaults && combSum != denseSum)
+            printf("  checksum mismatch\n");
+        freeCombTable(&comb);
+    }
+    free(cells);
+}
+
+int main(int argc, char** argv) {
+    int sizes[64];
+    int sizeCount = 0;
+    int lookups = DEFAULT_LOOKUPS;
+    rngState = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            lookups = atoi(argv[++i]);
+        else if (sizeCount < 64 && atoi(argv[i]) > 0)
+            sizes[sizeCount++] = atoi(argv[i]);
+        else {
+            fprintf(stderr, "Usage: %s [rule count]... [-n lookups]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (sizeCount == 0) {
+        sizes[sizeCount++] = 50;
+        sizes[sizeCount++] = 500;
+        sizes[sizeCount++] = 5000;
+    }
+    if (lookups <= 0)
+        lookups = DEFAULT_LOOKUPS;
+
+    printf("%-10s %6s %6s %8s %-9s %10s %8s %8s\n", "grammar", "rules", "rows", "filled", "table",
+           "bytes", "of dense", "ns/look");
+
+    // The generated tables of grammar.txt
+    report("grammar", numOfRules, ruleTable, NT_NOT_FOUND, lookups);
+
+    for (int run = 0; run < 2 * sizeCount; run++) {
+        int s = run % sizeCount;
+        GrammarShape shape = run < sizeCount ? SHAPE_KEYWORD : SHAPE_RANDOM;
+        SyntheticGrammar g;
+        generateGrammar(&g, sizes[s], shape);
+        RuleIndex* dense = buildDenseTable(&g.flat);
+        report(shapeName[shape], sizes[s], dense, g.flat.nonTerminals, lookups);
+        free(dense);
+        freeSyntheticGrammar(&g);
+    }
+    return 0;
+}
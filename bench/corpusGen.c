@@ -0,0 +1,581 @@
+/*
+   ====================================================================
+   Random Program Generator
+   --------------------------------------------------------------------
+   Writes syntactically valid programs of a requested size for lexer
+   and parser benchmarks, by walking the rules of the loaded grammar
+   from <program> down: every non-terminal is expanded with one of its
+   rules and every terminal is written as a lexeme the lexer maps back
+   to it. Output depends only on the options, so a seed reproduces a
+   corpus exactly.
+
+   Rule choice:
+     <otherFunctions>  continues until the function count or the size
+                       target is reached
+     <stmt>            weighted by the statement mix
+     X -> ... X | EPS  right-recursive lists continue with probability
+                       1 - 1 / (mean length + 1)
+     anything else     uniform
+   A rule that contains '(' and can recurse into itself (while, if,
+   parenthesized expressions and conditions) opens a nesting level;
+   at the depth limit only rules that need no further nesting are
+   chosen, which also keeps every expansion finite.
+
+   Errors are injected per token: half of them are characters the
+   lexer rejects, half drop the token or add an unexpected one.
+
+   Usage: corpusGen [-s size[K|M|G]] [-f functions] [-m a,w,i,o,c]
+                    [-b statements] [-d depth] [-i identifiers]
+                    [-c comment density] [-e error rate] [-r seed]
+                    [-o output]
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "lexer.h"
+#include "parser.h"
+#include "grammarCache.h"
+
+#define DEFAULT_SIZE         (64 * 1024)
+#define DEFAULT_STATEMENTS   5      // Mean statements per block
+#define DEFAULT_DEPTH        4
+#define DEFAULT_IDENTIFIERS  64
+#define DEFAULT_COMMENTS     0.05
+#define DEFAULT_LIST_LENGTH  1.0    // Mean length of other right-recursive lists
+#define STATEMENT_KINDS      5
+#define MAX_LEXEME           64
+#define OUTPUT_BUFFER        (1 << 20)
+
+// Statement kinds of the mix, by the non-terminal a <stmt> rule expands to
+static const char* statementKinds[STATEMENT_KINDS] = {
+    "<assignmentStmt>", "<iterativeStmt>", "<conditionalStmt>", "<ioStmt>", "<funCallStmt>"
+};
+
+// Lexemes of the tokens whose spelling is fixed
+static const char* fixedLexemes[TK_NOT_FOUND] = {
+    [ASSIGNOP] = "<---", [WITH] = "with", [PARAMETERS] = "parameters", [END] = "end",
+    [WHILE] = "while", [UNION] = "union", [ENDUNION] = "endunion", [DEFINETYPE] = "definetype",
+    [AS] = "as", [TYPE] = "type", [MAIN] = "_main", [GLOBAL] = "global",
+    [PARAMETER] = "parameter", [LIST] = "list", [SQL] = "[", [SQR] = "]",
+    [INPUT] = "input", [OUTPUT] = "output", [INT] = "int", [REAL] = "real",
+    [COMMA] = ",", [SEM] = ";", [COLON] = ":", [DOT] = ".", [ENDWHILE] = "endwhile",
+    [OP] = "(", [CL] = ")", [IF] = "if", [THEN] = "then", [ENDIF] = "endif",
+    [READ] = "read", [WRITE] = "write", [RETURN] = "return", [PLUS] = "+",
+    [MINUS] = "-", [MUL] = "*", [DIV] = "/", [CALL] = "call", [RECORD] = "record",
+    [ENDRECORD] = "endrecord", [ELSE] = "else", [AND] = "&&&", [OR] = "@@@",
+    [NOT] = "~", [LT] = "<", [LE] = "<=", [EQ] = "==", [GT] = ">", [GE] = ">=", [NE] = "!="
+};
+
+// Characters no token starts with
+static const char badCharacters[] = "?$^|{}";
+
+static const char* commentWords[] = {
+    "compute", "the", "sum", "of", "values", "record", "fields", "update", "loop",
+    "until", "done", "check", "result", "input", "output", "temporary", "total"
+};
+
+typedef struct Options {
+    uint64_t size;
+    int functions;                    // -1 to stop on size instead
+    double mix[STATEMENT_KINDS];
+    double statements;
+    int depth;
+    int identifiers;
+    double comments;
+    double errors;
+    uint64_t seed;
+    const char* output;
+} Options;
+
+typedef struct Generator {
+    Options opt;
+    uint64_t state;                   // xorshift64* state
+    FILE* out;
+    uint64_t written;
+    int functions;                    // Functions written so far
+    int indent;
+    bool lineStart;
+    bool defining;                    // The next FUNID names a new function
+    bool loopHeader;                  // Inside the condition of a while
+    int parens;                       // Open parentheses
+    // Grammar as flat symbol codes
+    int* ruleStart;
+    SymbolCode* symbols;
+    int* firstRule;                   // NT_NOT_FOUND + 1 offsets into ntRules
+    int* ntRules;                     // Rules grouped by left-hand side
+    bool* ruleNests;                  // Rule opens a nesting level
+    int* ruleNeed;                    // Nesting levels a rule needs to reach terminals
+    double* ruleWeight;               // Weight of every <stmt> rule, 0 elsewhere
+    double* continueProb;             // Continuation probability of right-recursive lists, < 0 for none
+    NonTerminal functionList;         // <otherFunctions>, or NT_NOT_FOUND
+    NonTerminal function;             // <function>, or NT_NOT_FOUND
+    NonTerminal statement;            // <stmt>, or NT_NOT_FOUND
+} Generator;
+
+// ------------------------- RANDOMNESS -------------------------
+
+static uint64_t nextRandom(Generator* g) {
+    g->state ^= g->state >> 12;
+    g->state ^= g->state << 25;
+    g->state ^= g->state >> 27;
+    return g->state * 2685821657736338717ULL;
+}
+
+static double uniform(Generator* g) {
+    return (nextRandom(g) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static int below(Generator* g, int n) {
+    return (int)(nextRandom(g) % (uint64_t) n);
+}
+
+// ------------------------- GRAMMAR -------------------------
+
+static NonTerminal findNonTerminal(const char* name) {
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        if (strcmp(nonTerminalToString[nt], name) == 0)
+            return (NonTerminal) nt;
+    }
+    return NT_NOT_FOUND;
+}
+
+static void prepareGrammar(Generator* g) {
+    // Flatten the rules and group them by left-hand side
+    int total = 0;
+    for (int r = 0; r < numOfRules; r++)
+        total += Grammar[r]->rhs->count;
+    g->ruleStart = calloc(numOfRules + 1, sizeof(int));
+    g->symbols = calloc(total + 1, sizeof(SymbolCode));
+    g->firstRule = calloc(NT_NOT_FOUND + 1, sizeof(int));
+    g->ntRules = calloc(numOfRules, sizeof(int));
+    g->ruleNests = calloc(numOfRules, sizeof(bool));
+    g->ruleNeed = calloc(numOfRules, sizeof(int));
+    g->ruleWeight = calloc(numOfRules, sizeof(double));
+    g->continueProb = calloc(numOfRules, sizeof(double));
+
+    int next = 0;
+    for (int r = 0; r < numOfRules; r++) {
+        g->ruleStart[r] = next;
+        for (SymbolNode* sn = Grammar[r]->rhs->head; sn; sn = sn->next)
+            g->symbols[next++] = symbolCodeOf(sn->symbol);
+        g->firstRule[Grammar[r]->lhs->value.nt + 1]++;
+    }
+    g->ruleStart[numOfRules] = next;
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++)
+        g->firstRule[nt + 1] += g->firstRule[nt];
+    int* fill = calloc(NT_NOT_FOUND, sizeof(int));
+    for (int r = 0; r < numOfRules; r++) {
+        int nt = Grammar[r]->lhs->value.nt;
+        g->ntRules[g->firstRule[nt] + fill[nt]++] = r;
+    }
+    free(fill);
+
+    // Non-terminals reachable from each one; every set fits a word
+    uint64_t reach[NT_NOT_FOUND] = {0};
+    for (int r = 0; r < numOfRules; r++) {
+        for (int i = g->ruleStart[r]; i < g->ruleStart[r + 1]; i++) {
+            if (IS_NT_CODE(g->symbols[i]))
+                reach[Grammar[r]->lhs->value.nt] |= (uint64_t) 1 << CODE_TO_NT(g->symbols[i]);
+        }
+    }
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+            uint64_t grown = reach[nt];
+            for (int c = 0; c < NT_NOT_FOUND; c++) {
+                if (reach[nt] >> c & 1)
+                    grown |= reach[c];
+            }
+            changed |= grown != reach[nt];
+            reach[nt] = grown;
+        }
+    }
+
+    // A rule nests when it holds '(' and a symbol leading back to its left-hand side
+    for (int r = 0; r < numOfRules; r++) {
+        NonTerminal lhs = Grammar[r]->lhs->value.nt;
+        bool paren = false, recursive = false;
+        for (int i = g->ruleStart[r]; i < g->ruleStart[r + 1]; i++) {
+            SymbolCode c = g->symbols[i];
+            if (c == OP)
+                paren = true;
+            else if (IS_NT_CODE(c) && (CODE_TO_NT(c) == lhs || (reach[CODE_TO_NT(c)] >> lhs & 1)))
+                recursive = true;
+        }
+        g->ruleNests[r] = paren && recursive;
+    }
+
+    // Fewest nesting levels each non-terminal needs, as a fixpoint
+    int need[NT_NOT_FOUND];
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++)
+        need[nt] = 1 << 20;
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (int r = 0; r < numOfRules; r++) {
+            int deepest = 0;
+            for (int i = g->ruleStart[r]; i < g->ruleStart[r + 1]; i++) {
+                if (IS_NT_CODE(g->symbols[i]) && need[CODE_TO_NT(g->symbols[i])] > deepest)
+                    deepest = need[CODE_TO_NT(g->symbols[i])];
+            }
+            g->ruleNeed[r] = deepest + g->ruleNests[r];
+            int lhs = Grammar[r]->lhs->value.nt;
+            if (g->ruleNeed[r] < need[lhs]) {
+                need[lhs] = g->ruleNeed[r];
+                changed = true;
+            }
+        }
+    }
+
+    // Statement mix and list lengths
+    g->functionList = findNonTerminal("<otherFunctions>");
+    g->function = findNonTerminal("<function>");
+    g->statement = findNonTerminal("<stmt>");
+    NonTerminal statements = findNonTerminal("<otherStmts>");
+    for (int r = 0; r < numOfRules; r++) {
+        NonTerminal lhs = Grammar[r]->lhs->value.nt;
+        g->continueProb[r] = -1;
+        if (lhs == g->statement && g->ruleStart[r + 1] - g->ruleStart[r] == 1) {
+            const char* kind = nonTerminalToString[CODE_TO_NT(g->symbols[g->ruleStart[r]])];
+            for (int k = 0; k < STATEMENT_KINDS; k++) {
+                if (strcmp(kind, statementKinds[k]) == 0)
+                    g->ruleWeight[r] = g->opt.mix[k];
+            }
+        }
+        SymbolCode last = g->symbols[g->ruleStart[r + 1] - 1];
+        if (IS_NT_CODE(last) && CODE_TO_NT(last) == lhs) {
+            double mean = lhs == statements ? g->opt.statements : DEFAULT_LIST_LENGTH;
+            g->continueProb[r] = 1 - 1 / (mean + 1);
+        }
+    }
+}
+
+// ------------------------- OUTPUT -------------------------
+
+static void writeText(Generator* g, const char* text) {
+    size_t n = strlen(text);
+    fwrite(text, 1, n, g->out);
+    g->written += n;
+}
+
+static void endLine(Generator* g) {
+    writeText(g, "\n");
+    g->lineStart = true;
+}
+
+static void writeLexeme(Generator* g, const char* lexeme) {
+    if (g->lineStart) {
+        if (uniform(g) < g->opt.comments) {
+            char comment[256] = "%";
+            for (int w = 2 + below(g, 6); w > 0; w--) {
+                strcat(comment, " ");
+                strcat(comment, commentWords[below(g, sizeof(commentWords) / sizeof(commentWords[0]))]);
+            }
+            writeText(g, comment);
+            endLine(g);
+        }
+        for (int i = 0; i < g->indent; i++)
+            writeText(g, "\t");
+        g->lineStart = false;
+    } else {
+        writeText(g, " ");
+    }
+    writeText(g, lexeme);
+}
+
+static void lettersOf(char* out, int n) {
+    // Bijective base 26 over a-z, so every index gets a distinct non-empty string
+    char tmp[16];
+    int len = 0;
+    do {
+        tmp[len++] = 'a' + n % 26;
+        n = n / 26 - 1;
+    } while (n >= 0);
+    while (len > 0)
+        *out++ = tmp[--len];
+    *out = '\0';
+}
+
+static void makeLexeme(Generator* g, Token tk, char* lexeme) {
+    int pick = below(g, g->opt.identifiers);
+    switch (tk) {
+        case ID: {
+            // [b-d][2-7][b-d]*[2-7]*, unique per index and at most 20 characters
+            char* p = lexeme;
+            *p++ = 'b' + pick % 3;
+            *p++ = '2' + pick / 3 % 6;
+            for (int n = pick / 18; n > 0; n /= 3)
+                *p++ = 'b' + n % 3;
+            *p = '\0';
+            break;
+        }
+        case FIELDID:
+            // No keyword starts with f
+            lexeme[0] = 'f';
+            lettersOf(lexeme + 1, pick);
+            break;
+        case RUID:
+            lexeme[0] = '#';
+            lettersOf(lexeme + 1, pick);
+            break;
+        case FUNID:
+            // Function names are _fn0, _fn1, ... in order of definition
+            sprintf(lexeme, "_fn%d", g->functions > 0 ? below(g, g->functions) : 0);
+            break;
+        case NUM:
+            sprintf(lexeme, "%d", below(g, 100000));
+            break;
+        case RNUM:
+            if (below(g, 4) == 0)
+                sprintf(lexeme, "%d.%02dE%c%02d", below(g, 1000), below(g, 100), below(g, 2) ? '+' : '-', below(g, 20));
+            else
+                sprintf(lexeme, "%d.%02d", below(g, 1000), below(g, 100));
+            break;
+        default:
+            strcpy(lexeme, fixedLexemes[tk]);
+            break;
+    }
+}
+
+static void writeToken(Generator* g, Token tk) {
+    char lexeme[MAX_LEXEME];
+    if (tk == EPS)
+        return;
+
+    if (g->opt.errors > 0 && uniform(g) < g->opt.errors) {
+        switch (below(g, 4)) {
+            case 0:
+            case 1: {
+                // A character the lexer rejects
+                char bad[2] = { badCharacters[below(g, sizeof(badCharacters) - 1)], '\0' };
+                writeLexeme(g, bad);
+                break;
+            }
+            case 2:
+                // Drop the token
+                return;
+            case 3: {
+                // Add a token the grammar does not expect here
+                Token extra;
+                do {
+                    extra = (Token) below(g, EPS);
+                } while (!fixedLexemes[extra] || extra == MAIN);
+                writeLexeme(g, fixedLexemes[extra]);
+                break;
+            }
+        }
+    }
+
+    if (tk == ENDWHILE || tk == ENDIF || tk == ELSE)
+        g->indent--;
+    if (tk == FUNID && g->defining) {
+        sprintf(lexeme, "_fn%d", g->functions++);
+        g->defining = false;
+    } else {
+        makeLexeme(g, tk, lexeme);
+    }
+    writeLexeme(g, lexeme);
+    if (tk == WHILE || tk == THEN || tk == ELSE)
+        g->indent++;
+
+    // The body of a while starts on the line after its condition
+    bool conditionEnds = false;
+    if (tk == WHILE)
+        g->loopHeader = true;
+    g->parens += (tk == OP) - (tk == CL);
+    if (g->parens < 0)
+        g->parens = 0;
+    if (tk == CL && g->loopHeader && g->parens == 0) {
+        g->loopHeader = false;
+        conditionEnds = true;
+    }
+    if (conditionEnds || tk == SEM || tk == END || tk == ENDWHILE || tk == ENDIF || tk == ENDRECORD
+        || tk == ENDUNION || tk == THEN || tk == ELSE || tk == MAIN)
+        endLine(g);
+}
+
+// ------------------------- WALK -------------------------
+
+static int chooseRule(Generator* g, NonTerminal nt, int level) {
+    int first = g->firstRule[nt], count = g->firstRule[nt + 1] - first;
+    int* rules = &g->ntRules[first];
+
+    if (nt == g->functionList) {
+        bool more = g->opt.functions >= 0 ? g->functions < g->opt.functions : g->written < g->opt.size;
+        for (int i = 0; i < count; i++) {
+            bool recursive = g->continueProb[rules[i]] >= 0;
+            if (recursive == more)
+                return rules[i];
+        }
+    }
+
+    // At the depth limit only rules that need no more nesting are allowed
+    int allowed[count];
+    int n = 0, leastNeed = 1 << 20;
+    for (int i = 0; i < count; i++) {
+        if (g->ruleNeed[rules[i]] < leastNeed)
+            leastNeed = g->ruleNeed[rules[i]];
+    }
+    for (int i = 0; i < count; i++) {
+        if (level < g->opt.depth || g->ruleNeed[rules[i]] <= leastNeed)
+            allowed[n++] = rules[i];
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (g->continueProb[allowed[i]] >= 0) {
+            if (n == 1 || uniform(g) < g->continueProb[allowed[i]])
+                return allowed[i];
+            // Take the other alternative
+            int rest = below(g, n - 1);
+            return allowed[rest >= i ? rest + 1 : rest];
+        }
+    }
+
+    if (nt == g->statement) {
+        double total = 0;
+        for (int i = 0; i < n; i++)
+            total += g->ruleWeight[allowed[i]];
+        if (total > 0) {
+            double x = uniform(g) * total;
+            for (int i = 0; i < n; i++) {
+                x -= g->ruleWeight[allowed[i]];
+                if (x < 0)
+                    return allowed[i];
+            }
+            return allowed[n - 1];
+        }
+    }
+    return allowed[below(g, n)];
+}
+
+static void generate(Generator* g) {
+    // Explicit stack of (symbol, nesting level); lists do not deepen it
+    int capacity = 1024, top = 0;
+    SymbolCode* codes = malloc(capacity * sizeof(SymbolCode));
+    int* levels = malloc(capacity * sizeof(int));
+    codes[top] = NT_CODE(program);
+    levels[top++] = 0;
+
+    while (top > 0) {
+        SymbolCode code = codes[--top];
+        int level = levels[top];
+        if (!IS_NT_CODE(code)) {
+            writeToken(g, (Token) code);
+            continue;
+        }
+
+        NonTerminal nt = CODE_TO_NT(code);
+        int r = chooseRule(g, nt, level);
+        int length = g->ruleStart[r + 1] - g->ruleStart[r];
+        if (top + length > capacity) {
+            capacity *= 2;
+            codes = realloc(codes, capacity * sizeof(SymbolCode));
+            levels = realloc(levels, capacity * sizeof(int));
+        }
+        int childLevel = level + g->ruleNests[r];
+        for (int i = g->ruleStart[r + 1] - 1; i >= g->ruleStart[r]; i--) {
+            codes[top] = g->symbols[i];
+            levels[top++] = childLevel;
+        }
+        // A function definition starts with its name
+        if (nt == g->function)
+            g->defining = true;
+    }
+    free(codes);
+    free(levels);
+}
+
+// ------------------------- MAIN -------------------------
+
+static uint64_t parseSize(const char* text) {
+    char* end;
+    double value = strtod(text, &end);
+    switch (*end) {
+        case 'k': case 'K': value *= 1024; break;
+        case 'm': case 'M': value *= 1024 * 1024; break;
+        case 'g': case 'G': value *= 1024.0 * 1024 * 1024; break;
+    }
+    return (uint64_t) value;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  -s size        stop after the function that passes this many bytes (K, M, G suffixes; default 64K)\n"
+            "  -f functions   write exactly this many functions besides _main instead\n"
+            "  -m a,w,i,o,c   weights of assignment, while, if, read/write and call statements (default 50,10,15,15,10)\n"
+            "  -b statements  mean statements per block (default %d)\n"
+            "  -d depth       deepest nesting of while/if and parentheses (default %d)\n"
+            "  -i count       identifiers, field names and record names to draw from (default %d)\n"
+            "  -c density     probability of a comment line before each line (default %.2f)\n"
+            "  -e rate        probability of an injected error per token (default 0)\n"
+            "  -r seed        random seed (default 1)\n"
+            "  -o file        output file (default stdout)\n",
+            program, DEFAULT_STATEMENTS, DEFAULT_DEPTH, DEFAULT_IDENTIFIERS, DEFAULT_COMMENTS);
+}
+
+int main(int argc, char** argv) {
+    Options opt = { DEFAULT_SIZE, -1, { 50, 10, 15, 15, 10 }, DEFAULT_STATEMENTS, DEFAULT_DEPTH,
+                    DEFAULT_IDENTIFIERS, DEFAULT_COMMENTS, 0, 1, NULL };
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc || argv[i][0] != '-') {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        switch (argv[i - 1][1]) {
+            case 's': opt.size = parseSize(value); break;
+            case 'f': opt.functions = atoi(value); break;
+            case 'm':
+                if (sscanf(value, "%lf,%lf,%lf,%lf,%lf", &opt.mix[0], &opt.mix[1], &opt.mix[2],
+                           &opt.mix[3], &opt.mix[4]) != STATEMENT_KINDS) {
+                    usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'b': opt.statements = atof(value); break;
+            case 'd': opt.depth = atoi(value); break;
+            case 'i': opt.identifiers = atoi(value); break;
+            case 'c': opt.comments = atof(value); break;
+            case 'e': opt.errors = atof(value); break;
+            case 'r': opt.seed = strtoull(value, NULL, 0); break;
+            case 'o': opt.output = value; break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (opt.identifiers < 1 || opt.depth < 0 || opt.statements < 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    initTokenStrings();
+    initializeNonTerminalToString();
+    if (!loadGrammarTables(GRAMMAR_FILE))
+        return 1;
+
+    Generator g;
+    memset(&g, 0, sizeof(g));
+    g.opt = opt;
+    g.state = opt.seed * 0x9E3779B97F4A7C15ULL + 1;
+    g.lineStart = true;
+    g.out = opt.output ? fopen(opt.output, "w") : stdout;
+    if (!g.out) {
+        fprintf(stderr, "Could not open %s for writing\n", opt.output);
+        return 1;
+    }
+    setvbuf(g.out, NULL, _IOFBF, OUTPUT_BUFFER);
+
+    prepareGrammar(&g);
+    generate(&g);
+
+    if (opt.output && fclose(g.out) != 0) {
+        fprintf(stderr, "Could not write %s\n", opt.output);
+        return 1;
+    }
+    fprintf(stderr, "Wrote %llu bytes, %d functions\n", (unsigned long long) g.written, g.functions);
+    return 0;
+}
@@ -0,0 +1,97 @@
+/*
+   ====================================================================
+   Rule Expansion Benchmark
+   --------------------------------------------------------------------
+   Measures the cost of expanding each grammar rule on the parse stack:
+   once the way parseTokens() used to, walking the rule's SymbolList
+   to label the children and pushing them back to front,
+   and once through expandRule() with the rule's compiled push order.
+   Both build the same children; times are per expansion, including
+   the parent node.
+
+   Usage: expandBench [-n expansions per rule]
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lexer.h"
+#include "parser.h"
+#include "grammarCache.h"
+#include "arena.h"
+
+#define DEFAULT_EXPANSIONS  200000
+#define EXPANSIONS_PER_RESET  4096
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void expandFromList(ParseTree* tree, Stack* stack, uint32_t parent, GrammarRule* rule) {
+    // The expansion loop parseTokens() ran before rules were compiled
+    uint32_t child = addChildren(tree, parent, rule->rhs->count);
+    for (SymbolNode* trItr = rule->rhs->head; trItr; trItr = trItr->next, child++)
+        tree->nodes[child].code = trItr->symbol->isNonTerminal
+            ? NT_CODE(trItr->symbol->value.nt) : (SymbolCode) trItr->symbol->value.t;
+    for (int chi = tree->nodes[parent].childCount - 1; chi >= 0; chi--)
+        pushStack(stack, tree->nodes[parent].firstChild + (uint32_t) chi);
+}
+
+static double timeRule(int r, int expansions, bool compiled) {
+    double start = now();
+    for (int done = 0; done < expansions; done += EXPANSIONS_PER_RESET) {
+        ParseTree* tree = createParseTree(NULL);
+        Stack* stack = initializeStack();
+        int batch = expansions - done < EXPANSIONS_PER_RESET ? expansions - done : EXPANSIONS_PER_RESET;
+        for (int i = 0; i < batch; i++) {
+            // Each expansion gets a fresh parent, as the root's only child
+            uint32_t parent = addChildren(tree, PARSE_TREE_ROOT, 1);
+            tree->nodes[parent].code = NT_CODE(compiledRules[r].lhs);
+            if (compiled)
+                expandRule(tree, stack, parent, &compiledRules[r]);
+            else
+                expandFromList(tree, stack, parent, Grammar[r]);
+            // Consume the children the way matching terminals would
+            for (int c = 0; c < tree->nodes[parent].childCount; c++)
+                popStack(stack);
+        }
+        freeParseTree(tree);
+        resetArena(&compilationArena);
+    }
+    return (now() - start) / expansions * 1e9;
+}
+
+int main(int argc, char** argv) {
+    int expansions = DEFAULT_EXPANSIONS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            expansions = atoi(argv[++i]);
+    }
+    if (expansions <= 0) {
+        fprintf(stderr, "Usage: %s [-n expansions per rule]\n", argv[0]);
+        return 1;
+    }
+
+    initTokenStrings();
+    initializeNonTerminalToString();
+    if (!loadGrammarTables(GRAMMAR_FILE))
+        return 1;
+
+    printf("%5s  %-28s %6s %12s %12s %9s\n", "rule", "lhs", "length", "list ns", "compiled ns", "speedup");
+    double listTotal = 0, compiledTotal = 0;
+    for (int r = 0; r < numOfRules; r++) {
+        double listNs = timeRule(r, expansions, false);
+        double compiledNs = timeRule(r, expansions, true);
+        listTotal += listNs;
+        compiledTotal += compiledNs;
+        printf("%5d  %-28s %6d %12.1f %12.1f %8.2fx\n", r, nonTerminalToString[compiledRules[r].lhs],
+               compiledRules[r].length, listNs, compiledNs, listNs / compiledNs);
+    }
+    printf("%5s  %-28s %6s %12.1f %12.1f %8.2fx\n", "mean", "", "",
+           listTotal / numOfRules, compiledTotal / numOfRules, listTotal / compiledTotal);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+   ====================================================================
+   FIRST/FOLLOW Solver Benchmark
+   --------------------------------------------------------------------
+   Generates random grammars of the given sizes over the real token
+   alphabet and computes their FIRST and FOLLOW sets twice: with the
+   rule sweeps the parser used to run until nothing changed, and with
+   solveFirstFollow(). The results are compared set by set.
+
+   The "random" and "layered" shapes of syntheticGrammar.h are
+   measured: the first forms large cycles, the second makes
+   dependencies run against the order of the rules.
+
+   Usage: firstFollowBench [rule count]... [-s seed]
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "parserDef.h"
+#include "firstFollow.h"
+#include "syntheticGrammar.h"
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int sweepFirstFollow(const FlatGrammar* g, TokenSet* first, TokenSet* follow) {
+    // The fixpoint sweeps the parser ran before the solver, on bitsets
+    int sweeps = 0;
+    memset(first, 0, g->nonTerminals * sizeof(TokenSet));
+    memset(follow, 0, g->nonTerminals * sizeof(TokenSet));
+    bool modified = true;
+    while (modified) {
+        modified = false;
+        sweeps++;
+        for (int r = 0; r < g->ruleCount; r++) {
+            int lhs = CODE_TO_NT(g->ruleLhs[r]);
+            TokenSet grown = first[lhs] | firstOfSequence(g, first, g->ruleStart[r], g->ruleStart[r + 1]);
+            if (grown != first[lhs]) {
+                first[lhs] = grown;
+                modified = true;
+            }
+        }
+    }
+
+    follow[g->startSymbol] |= TOKEN_BIT(DOLLAR);
+    modified = true;
+    while (modified) {
+        modified = false;
+        sweeps++;
+        for (int r = 0; r < g->ruleCount; r++) {
+            int lhs = CODE_TO_NT(g->ruleLhs[r]);
+            for (uint32_t i = g->ruleStart[r]; i < g->ruleStart[r + 1]; i++) {
+                if (!IS_NT_CODE(g->symbols[i]))
+                    continue;
+                int nt = CODE_TO_NT(g->symbols[i]);
+                TokenSet rest = firstOfSequence(g, first, i + 1, g->ruleStart[r + 1]);
+                TokenSet grown = follow[nt] | (rest & ~TOKEN_BIT(EPS));
+                if (IN_TOKEN_SET(rest, EPS))
+                    grown |= follow[lhs];
+                if (grown != follow[nt]) {
+                    follow[nt] = grown;
+                    modified = true;
+                }
+            }
+        }
+    }
+    return sweeps;
+}
+
+int main(int argc, char** argv) {
+    int sizes[64];
+    int sizeCount = 0;
+    rngState = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            rngState = strtoull(argv[++i], NULL, 0) | 1;
+        else if (sizeCount < 64 && atoi(argv[i]) > 0)
+            sizes[sizeCount++] = atoi(argv[i]);
+        else {
+            fprintf(stderr, "Usage: %s [rule count]... [-s seed]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (sizeCount == 0) {
+        sizes[sizeCount++] = 100;
+        sizes[sizeCount++] = 1000;
+        sizes[sizeCount++] = 10000;
+    }
+
+    printf("%-8s %8s %8s %8s %8s %12s %12s %10s\n", "shape", "rules", "nts", "symbols", "sweeps",
+           "sweep s", "solver s", "speedup");
+    int failures = 0;
+    for (int run = 0; run < 2 * sizeCount; run++) {
+        int s = run % sizeCount;
+        GrammarShape shape = run >= sizeCount ? SHAPE_LAYERED : SHAPE_RANDOM;
+        SyntheticGrammar g;
+        generateGrammar(&g, sizes[s], shape);
+        int nts = g.flat.nonTerminals;
+        TokenSet* first = (TokenSet*) malloc(nts * sizeof(TokenSet));
+        TokenSet* follow = (TokenSet*) malloc(nts * sizeof(TokenSet));
+        TokenSet* refFirst = (TokenSet*) malloc(nts * sizeof(TokenSet));
+        TokenSet* refFollow = (TokenSet*) malloc(nts * sizeof(TokenSet));
+
+        double start = now();
+        int sweeps = sweepFirstFollow(&g.flat, refFirst, refFollow);
+        double sweepSecs = now() - start;
+
+        // The solver, allocations included, is fast enough to need repeating
+        int repeats = 0;
+        start = now();
+        do {
+            solveFirstFollow(&g.flat, first, follow);
+            repeats++;
+        } while (now() - start < 0.2);
+        double solverSecs = (now() - start) / repeats;
+
+        int mismatches = 0;
+        for (int nt = 0; nt < nts; nt++)
+            mismatches += (first[nt] != refFirst[nt]) + (follow[nt] != refFollow[nt]);
+        printf("%-8s %8d %8d %8u %8d %12.6f %12.6f %9.1fx%s\n", shapeName[shape], sizes[s], nts, g.ruleStart[sizes[s]], sweeps,
+               sweepSecs, solverSecs, sweepSecs / solverSecs, mismatches ? "  MISMATCH" : "");
+        failures += mismatches;
+
+        free(first); free(follow); free(refFirst); free(refFollow);
+        freeSyntheticGrammar(&g);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+/*
+   ====================================================================
+   Intern Table Scaling Benchmark
+   --------------------------------------------------------------------
+   Lexes the given source files repeatedly on 1, 2, 4, ... 64 threads.
+   Every thread interns into one shared InternTable; the same amount
+   of work is split across the threads in each round, so the wall time
+   shows how the shared path scales. A single-threaded run with per-file
+   symbol tables is printed first as the baseline.
+
+   Usage: internBench <source file>... [-n lexes per round]
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "lexer.h"
+#include "arena.h"
+#include "intern.h"
+
+#define MAX_BENCH_THREADS  64
+#define DEFAULT_LEXES      512
+
+typedef struct BenchJob {
+    char** files;            // Source files to lex, in turn
+    SourceFileId* fileIds;   // Registered ids of those files
+    int fileCount;           // Number of source files
+    int first, last;         // Range of lex jobs handled by this thread
+    InternTable* symbols;    // Shared table, or NULL for per-file tables
+    long tokens;             // Tokens produced by this thread
+} BenchJob;
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void* lexJobs(void* arg) {
+    BenchJob* job = (BenchJob*) arg;
+    for (int i = job->first; i < job->last; i++) {
+        int f = i % job->fileCount;
+        FILE* fp = fopen(job->files[f], "r");
+        if (!fp) {
+            fprintf(stderr, "Cannot open %s\n", job->files[f]);
+            continue;
+        }
+        TokenBuffer* tokens = job->symbols
+            ? getAllTokensShared(fp, job->fileIds[f], job->symbols)
+            : getAllTokens(fp, job->fileIds[f]);
+        fclose(fp);
+        if (tokens)
+            job->tokens += tokens->count;
+        freeTokenBuffer(tokens);
+        resetArena(&compilationArena);
+    }
+    return NULL;
+}
+
+static double runRound(int threads, int lexes, char** files, SourceFileId* ids, int fileCount,
+                       InternTable* symbols, long* tokens) {
+    pthread_t tid[MAX_BENCH_THREADS];
+    BenchJob jobs[MAX_BENCH_THREADS];
+    double start = now();
+    for (int t = 0; t < threads; t++) {
+        jobs[t] = (BenchJob) { files, ids, fileCount, lexes * t / threads, lexes * (t + 1) / threads, symbols, 0 };
+        pthread_create(&tid[t], NULL, lexJobs, &jobs[t]);
+    }
+    *tokens = 0;
+    for (int t = 0; t < threads; t++) {
+        pthread_join(tid[t], NULL);
+        *tokens += jobs[t].tokens;
+    }
+    return now() - start;
+}
+
+int main(int argc, char** argv) {
+    char* files[256];
+    SourceFileId ids[256];
+    int fileCount = 0;
+    int lexes = DEFAULT_LEXES;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            lexes = atoi(argv[++i]);
+        else if (fileCount < 256)
+            files[fileCount++] = argv[i];
+    }
+    if (fileCount == 0 || lexes <= 0) {
+        fprintf(stderr, "Usage: %s <source file>... [-n lexes per round]\n", argv[0]);
+        return 1;
+    }
+
+    // Shared state is set up before any thread starts
+    initTokenStrings();
+    for (int f = 0; f < fileCount; f++)
+        ids[f] = registerSourceFile(files[f]);
+
+    long tokens;
+    double base = runRound(1, lexes, files, ids, fileCount, NULL, &tokens);
+    printf("%-10s %8s %12s %14s %10s\n", "table", "threads", "seconds", "tokens/s", "speedup");
+    printf("%-10s %8d %12.4f %14.0f %10s\n", "per-file", 1, base, tokens / base, "-");
+
+    double single = 0;
+    for (int threads = 1; threads <= MAX_BENCH_THREADS; threads *= 2) {
+        InternTable* symbols = createInternTable(1 << 16);
+        double secs = runRound(threads, lexes, files, ids, fileCount, symbols, &tokens);
+        if (threads == 1)
+            single = secs;
+        printf("%-10s %8d %12.4f %14.0f %9.2fx  (%u symbols)\n", "shared", threads, secs,
+               tokens / secs, single / secs, internCount(symbols));
+        destroyInternTable(symbols);
+    }
+    return 0;
+}
@@ -0,0 +1,221 @@
+/*
+   ====================================================================
+   Parse Stack Benchmark
+   --------------------------------------------------------------------
+   Replays the pushes and pops parseTokens() makes on a given program
+   against three stacks: a linked list with a malloc() per push and a
+   free() per pop, the same list drawing its items from a slab pool
+   (the stack parseTokens() used before), and the contiguous Stack of
+   stack.h. The trace comes from an LL(1) walk of the program's tokens
+   over the parser's own tables, so every stack sees exactly the work
+   of a real parse; times are per stack operation and per parse.
+
+   Usage: stackBench [-n passes] <program file>
+          (bench/corpusGen writes programs of any size)
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "lexer.h"
+#include "parser.h"
+#include "sourceLoc.h"
+#include "arena.h"
+
+#define DEFAULT_PASSES  20
+#define TRACE_POP       0    // Trace entry of a pop; other entries push that many nodes
+
+// ListItem: One entry of the linked list stacks.
+typedef struct ListItem {
+    uint32_t data;
+    struct ListItem* next;
+} ListItem;
+
+static SlabPool listItemPool = SLAB_POOL(ListItem, NULL);
+
+static double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// ------------------------- TRACE -------------------------
+
+static int* recordTrace(const ParserTables* tables, const TokenBuffer* tokens, int* length, long* operations) {
+    /*
+       Walks the tokens with a stack of symbol codes the way parseTokens()
+       walks them with parse nodes and records each expansion (its rule's
+       length) and each pop. The walk stops at the first syntax error.
+    */
+    int capacity = 1024, count = 0, depth = 0, depthCapacity = 256;
+    int* trace = (int*) malloc(capacity * sizeof(int));
+    SymbolCode* codes = (SymbolCode*) malloc(depthCapacity * sizeof(SymbolCode));
+    codes[depth++] = NT_CODE(program);
+    trace[count++] = 1;
+    *operations = 1;
+
+    int next = 0;
+    while (depth > 0) {
+        while (next < tokens->count && (tokens->kind[next] == COMMENT || tokens->kind[next] >= LEXICAL_ERROR))
+            next++;
+        Token tk = next < tokens->count ? (Token) tokens->kind[next] : DOLLAR;
+        SymbolCode top = codes[depth - 1];
+        if (count + 1 >= capacity) {
+            capacity *= 2;
+            trace = (int*) realloc(trace, capacity * sizeof(int));
+        }
+
+        if (!IS_NT_CODE(top)) {
+            if (top != EPS && top != tk)
+                break;
+            if (top != EPS)
+                next++;
+            depth--;
+            trace[count++] = TRACE_POP;
+            *operations += 1;
+            continue;
+        }
+
+        RuleIndex rule = tables->cells[CODE_TO_NT(top) * TK_NOT_FOUND + tk];
+        if (rule == NO_RULE)
+            break;
+        const CompiledRule* cr = &tables->rules[rule - 1];
+        depth--;
+        if (depth + cr->length > depthCapacity) {
+            while (depth + cr->length > depthCapacity)
+                depthCapacity *= 2;
+            codes = (SymbolCode*) realloc(codes, depthCapacity * sizeof(SymbolCode));
+        }
+        for (int i = 0; i < cr->length; i++)
+            codes[depth++] = cr->push[i];
+        trace[count++] = TRACE_POP;
+        trace[count++] = cr->length;
+        *operations += 1 + cr->length;
+    }
+    if (depth > 0)
+        fprintf(stderr, "Syntax error after %d tokens; timing the parse up to there\n", next);
+
+    free(codes);
+    *length = count;
+    return trace;
+}
+
+// ------------------------- REPLAYS -------------------------
+
+static uintptr_t replayMalloc(const int* trace, int length, uint32_t node) {
+    uintptr_t seen = 0;
+    ListItem* top = NULL;
+    for (int i = 0; i < length; i++) {
+        if (trace[i] == TRACE_POP) {
+            ListItem* item = top;
+            seen += (uintptr_t) item->data;
+            top = item->next;
+            free(item);
+            continue;
+        }
+        for (int k = 0; k < trace[i]; k++) {
+            ListItem* item = (ListItem*) malloc(sizeof(ListItem));
+            item->data = node;
+            item->next = top;
+            top = item;
+        }
+    }
+    return seen;
+}
+
+static uintptr_t replayPool(const int* trace, int length, uint32_t node) {
+    uintptr_t seen = 0;
+    ListItem* top = NULL;
+    for (int i = 0; i < length; i++) {
+        if (trace[i] == TRACE_POP) {
+            ListItem* item = top;
+            seen += (uintptr_t) item->data;
+            top = item->next;
+            poolFree(&listItemPool, item);
+            continue;
+        }
+        for (int k = 0; k < trace[i]; k++) {
+            ListItem* item = (ListItem*) poolAlloc(&listItemPool);
+            item->data = node;
+            item->next = top;
+            top = item;
+        }
+    }
+    return seen;
+}
+
+static uintptr_t replayArray(const int* trace, int length, uint32_t node) {
+    uintptr_t seen = 0;
+    Stack* stack = initializeStack();
+    for (int i = 0; i < length; i++) {
+        if (trace[i] == TRACE_POP) {
+            seen += (uintptr_t) peekStack(stack);
+            popStack(stack);
+            continue;
+        }
+        reserveStack(stack, trace[i]);
+        for (int k = 0; k < trace[i]; k++)
+            pushStack(stack, node);
+    }
+    return seen;
+}
+
+static double timeReplay(uintptr_t (*replay)(const int*, int, uint32_t), const int* trace, int length,
+                         int passes, uintptr_t* check) {
+    double start = now();
+    for (int p = 0; p < passes; p++) {
+        *check += replay(trace, length, (uint32_t) p);
+        resetArena(&compilationArena);
+    }
+    return (now() - start) / passes;
+}
+
+int main(int argc, char** argv) {
+    int passes = DEFAULT_PASSES;
+    const char* path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            passes = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+    if (!path || passes <= 0) {
+        fprintf(stderr, "Usage: %s [-n passes] <program file>\n", argv[0]);
+        return 1;
+    }
+
+    const ParserTables* tables = initializeParserTables();
+    if (!tables)
+        return 1;
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "Could not open %s\n", path);
+        return 1;
+    }
+    TokenBuffer* tokens = lexInput(fp, NULL, registerSourceFile(path));
+    fclose(fp);
+
+    int length;
+    long operations;
+    int* trace = recordTrace(tables, tokens, &length, &operations);
+    printf("%d tokens, %ld stack operations per parse\n\n", tokens->count, operations);
+
+    uintptr_t check = 0;
+    double mallocTime = timeReplay(replayMalloc, trace, length, passes, &check);
+    double poolTime = timeReplay(replayPool, trace, length, passes, &check);
+    double arrayTime = timeReplay(replayArray, trace, length, passes, &check);
+
+    printf("%-22s %12s %12s %9s\n", "stack", "ns / op", "ms / parse", "speedup");
+    printf("%-22s %12.2f %12.3f %8.2fx\n", "malloc per push", mallocTime / operations * 1e9, mallocTime * 1e3, 1.0);
+    printf("%-22s %12.2f %12.3f %8.2fx\n", "slab pool list", poolTime / operations * 1e9, poolTime * 1e3, mallocTime / poolTime);
+    printf("%-22s %12.2f %12.3f %8.2fx\n", "contiguous array", arrayTime / operations * 1e9, arrayTime * 1e3, mallocTime / arrayTime);
+    if (check == 1)
+        printf("\n");  // Keeps the replays from being optimized away
+
+    free(trace);
+    freeTokenBuffer(tokens);
+    return 0;
+}
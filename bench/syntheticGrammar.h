@@ -0,0 +1,114 @@
+/*
+   ====================================================================
+   Synthetic Grammars for Benchmarks
+   --------------------------------------------------------------------
+   Random grammars over the real token alphabet, in the flat form of
+   firstFollow.h. They use about one non-terminal per four rules, a
+   tenth of them epsilon rules, and right-hand sides of up to six
+   symbols that lean towards non-terminals. Three shapes are available:
+   "random" draws non-terminals from the whole grammar, so that large
+   cycles form; "layered" lists the rules of each non-terminal in
+   order and only refers to the next few, like a precedence chain;
+   "keyword" starts most rules with a terminal, like statements led
+   by a keyword, which gives the sparse tables of LL(1) grammars.
+   ====================================================================
+*/
+
+#ifndef SYNTHETIC_GRAMMAR_H
+#define SYNTHETIC_GRAMMAR_H
+
+#include <stdlib.h>
+#include "parserDef.h"
+#include "firstFollow.h"
+
+#define MAX_RHS_LENGTH  6
+
+typedef enum GrammarShape {
+    SHAPE_RANDOM,
+    SHAPE_LAYERED,
+    SHAPE_KEYWORD
+} GrammarShape;
+
+static const char* shapeName[] = { "random", "layered", "keyword" };
+
+typedef struct SyntheticGrammar {
+    FlatGrammar flat;        // View passed to the solvers
+    uint32_t* ruleStart;     // Backing arrays of the view
+    SymbolCode* ruleLhs;
+    SymbolCode* symbols;
+} SyntheticGrammar;
+
+static uint64_t rngState;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return (uint32_t)(rngState >> 16);
+}
+
+static SymbolCode randomTerminal() {
+    SymbolCode tk;
+    do {
+        tk = (SymbolCode)(nextRandom() % TK_NOT_FOUND);
+    } while (tk == EPS || tk == DOLLAR);
+    return tk;
+}
+
+static void generateGrammar(SyntheticGrammar* g, int rules, GrammarShape shape) {
+    bool layered = shape == SHAPE_LAYERED;
+    int nts = rules / 4 > 0 ? rules / 4 : 1;
+    g->ruleStart = (uint32_t*) malloc((rules + 1) * sizeof(uint32_t));
+    g->ruleLhs = (SymbolCode*) malloc(rules * sizeof(SymbolCode));
+    g->symbols = (SymbolCode*) malloc((size_t) rules * MAX_RHS_LENGTH * sizeof(SymbolCode));
+
+    uint32_t next = 0;
+    for (int r = 0; r < rules; r++) {
+        // Every non-terminal gets at least one rule
+        int lhs;
+        if (layered)
+            lhs = (int)((int64_t) r * nts / rules);
+        else
+            lhs = r < nts ? r : (int)(nextRandom() % nts);
+        g->ruleLhs[r] = NT_CODE(lhs);
+        g->ruleStart[r] = next;
+        if (nextRandom() % (shape == SHAPE_KEYWORD ? 20 : 10) == 0) {
+            g->symbols[next++] = EPS;
+            continue;
+        }
+        int length = 1 + (int)(nextRandom() % MAX_RHS_LENGTH);
+        for (int i = 0; i < length; i++) {
+            if (shape == SHAPE_KEYWORD && i == 0 && nextRandom() % 10 != 0)
+                g->symbols[next++] = randomTerminal();
+            else if (nextRandom() % 5 < 3 && (!layered || lhs + 1 < nts))
+                g->symbols[next++] = layered
+                    ? NT_CODE(lhs + 1 + (int)(nextRandom() % 8) % (nts - lhs - 1))
+                    : NT_CODE(nextRandom() % nts);
+            else
+                g->symbols[next++] = randomTerminal();
+        }
+    }
+    g->ruleStart[rules] = next;
+    g->flat = (FlatGrammar) { rules, nts, 0, g->ruleStart, g->ruleLhs, g->symbols };
+}
+
+static TokenSet firstOfSequence(const FlatGrammar* g, const TokenSet* first, uint32_t from, uint32_t to) {
+    TokenSet res = 0;
+    for (uint32_t i = from; i < to; i++) {
+        SymbolCode code = g->symbols[i];
+        if (!IS_NT_CODE(code))
+            return res | TOKEN_BIT(code);
+        res |= first[CODE_TO_NT(code)] & ~TOKEN_BIT(EPS);
+        if (!IN_TOKEN_SET(first[CODE_TO_NT(code)], EPS))
+            return res;
+    }
+    return res | TOKEN_BIT(EPS);
+}
+
+static void freeSyntheticGrammar(SyntheticGrammar* g) {
+    free(g->ruleStart);
+    free(g->ruleLhs);
+    free(g->symbols);
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*
+   ====================================================================
+   Comb-Vector Parse Table Implementation
+   --------------------------------------------------------------------
+   First-fit row displacement, densest rows first; see combTable.h.
+   The search for a base starts at the lowest free slot, which keeps
+   building fast once the front of the vector has filled up.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "combTable.h"
+
+// ------------------------- HELPERS -------------------------
+
+static RuleIndex rowDefault(const RuleIndex* row, int columns) {
+    /*
+       Finds the most frequent rule of a row, the lowest on ties.
+    */
+    RuleIndex best = NO_RULE;
+    int bestCount = 0;
+    for (int c = 0; c < columns; c++) {
+        if (row[c] == NO_RULE || row[c] == best)
+            continue;
+        int count = 0;
+        for (int k = 0; k < columns; k++)
+            count += row[k] == row[c];
+        if (count > bestCount || (count == bestCount && row[c] < best)) {
+            best = row[c];
+            bestCount = count;
+        }
+    }
+    return best;
+}
+
+static int entryCount(const RuleIndex* row, int columns, RuleIndex fallback) {
+    /*
+       Counts the cells of a row that must go into the vector.
+    */
+    int count = 0;
+    for (int c = 0; c < columns; c++)
+        count += row[c] != NO_RULE && row[c] != fallback;
+    return count;
+}
+
+static int compareByEntries(const void* a, const void* b) {
+    /*
+       Orders rows by decreasing entry count; the count sits in the high bits.
+    */
+    int64_t x = *(const int64_t*) a, y = *(const int64_t*) b;
+    return x < y ? 1 : x > y ? -1 : 0;
+}
+
+// ------------------------- BUILD / LOOKUP -------------------------
+
+bool buildCombTable(CombTable* comb, const RuleIndex* dense, int rows, int columns, bool useDefaults) {
+    /*
+       Places every row at the lowest base where all of its entries land
+       on free slots. Bases are never negative and the vector always
+       extends a full row past the last base, so any column of any row
+       can be looked up without a bounds check.
+    */
+    memset(comb, 0, sizeof(CombTable));
+    if (rows >= COMB_NO_ROW || columns <= 0) {
+        fprintf(stderr, "Table of %d x %d cells cannot be compressed\n", rows, columns);
+        return false;
+    }
+    comb->rows = rows;
+    comb->columns = columns;
+
+    size_t capacity = (size_t) rows * columns + columns;
+    comb->base = (int32_t*) calloc(rows ? rows : 1, sizeof(int32_t));
+    comb->defaults = (RuleIndex*) calloc(rows ? rows : 1, sizeof(RuleIndex));
+    comb->slots = (CombSlot*) malloc(capacity * sizeof(CombSlot));
+    int64_t* order = (int64_t*) malloc((rows ? rows : 1) * sizeof(int64_t));
+    if (!comb->base || !comb->defaults || !comb->slots || !order) {
+        fprintf(stderr, "Memory allocation failed for the compressed parse table\n");
+        free(order);
+        freeCombTable(comb);
+        return false;
+    }
+    for (size_t i = 0; i < capacity; i++)
+        comb->slots[i] = (CombSlot) { COMB_NO_ROW, NO_RULE };
+
+    for (int r = 0; r < rows; r++) {
+        const RuleIndex* row = dense + (size_t) r * columns;
+        comb->defaults[r] = useDefaults ? rowDefault(row, columns) : NO_RULE;
+        order[r] = ((int64_t) entryCount(row, columns, comb->defaults[r]) << 32) | (uint32_t)(rows - 1 - r);
+    }
+    qsort(order, rows, sizeof(int64_t), compareByEntries);
+
+    int size = columns;
+    int lowestFree = 0;
+    for (int i = 0; i < rows; i++) {
+        int r = rows - 1 - (int)(uint32_t) order[i];
+        const RuleIndex* row = dense + (size_t) r * columns;
+        RuleIndex fallback = comb->defaults[r];
+        if ((order[i] >> 32) == 0)
+            continue;   // Nothing to place; base 0 never matches the check
+
+        // Lowest base whose slots are all free; the first entry cannot land below lowestFree
+        int firstColumn = 0;
+        while (row[firstColumn] == NO_RULE || row[firstColumn] == fallback)
+            firstColumn++;
+        int b = lowestFree > firstColumn ? lowestFree - firstColumn : 0;
+        for (;; b++) {
+            int c = firstColumn;
+            for (; c < columns; c++) {
+                if (row[c] != NO_RULE && row[c] != fallback && comb->slots[b + c].check != COMB_NO_ROW)
+                    break;
+            }
+            if (c == columns)
+                break;
+        }
+        comb->base[r] = b;
+        for (int c = firstColumn; c < columns; c++) {
+            if (row[c] != NO_RULE && row[c] != fallback)
+                comb->slots[b + c] = (CombSlot) { (uint16_t) r, row[c] };
+        }
+        if (b + columns > size)
+            size = b + columns;
+        while (comb->slots[lowestFree].check != COMB_NO_ROW)
+            lowestFree++;
+    }
+    free(order);
+
+    // Give back the slack; the vector only shrinks
+    comb->size = size;
+    CombSlot* slots = (CombSlot*) realloc(comb->slots, size * sizeof(CombSlot));
+    if (slots) comb->slots = slots;
+    return true;
+}
+
+size_t combTableBytes(const CombTable* comb) {
+    /*
+       Counts the bytes of the three arrays.
+    */
+    return (size_t) comb->rows * (sizeof(int32_t) + sizeof(RuleIndex))
+         + (size_t) comb->size * sizeof(CombSlot);
+}
+
+void freeCombTable(CombTable* comb) {
+    /*
+       Releases the arrays and clears the table.
+    */
+    free(comb->base);
+    free(comb->defaults);
+    free(comb->slots);
+    memset(comb, 0, sizeof(CombTable));
+}
@@ -0,0 +1,68 @@
+/*
+   ====================================================================
+   Comb-Vector Parse Table - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   Compresses a dense [row][column] table of rule indices by row
+   displacement: the non-empty cells of every row are dropped into one
+   shared vector at an offset (the row's base) chosen so that no two
+   rows claim the same slot. A parallel check vector records which row
+   owns each slot, so a lookup is
+
+     slot = base[row] + column
+     value = check[slot] == row ? next[slot] : defaults[row]
+
+   check and next are interleaved, so a lookup touches one slot.
+
+   Rows may also get a default: their most frequent rule, whose cells
+   are then left out of the vector entirely. This trades exact error
+   detection for size, as LR default reductions do: an error cell
+   reads as the default, and the error surfaces at the next terminal
+   mismatch instead. Without defaults every row defaults to NO_RULE
+   and lookups match the dense table exactly.
+   ====================================================================
+*/
+
+#ifndef COMB_TABLE_H
+#define COMB_TABLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "parserDef.h"
+
+#define COMB_NO_ROW  0xFFFF   // Check value of a slot no row owns
+
+// CombSlot: One slot of the packed vector.
+typedef struct CombSlot {
+    uint16_t check;         // Row owning the slot, COMB_NO_ROW if none
+    RuleIndex next;         // Cell value stored in the slot
+} CombSlot;
+
+// CombTable: Row-displaced form of a dense table.
+typedef struct CombTable {
+    int rows;               // Rows of the dense table
+    int columns;            // Columns of the dense table
+    int size;               // Slots in the vector
+    int32_t* base;          // Offset of every row in the vector
+    RuleIndex* defaults;    // Value of every row's cells missing from the vector
+    CombSlot* slots;        // Packed cells
+} CombTable;
+
+/* ----------- Comb Table Functions ----------- */
+// Compress a dense rows x columns table. With useDefaults each row's most
+// frequent rule becomes its default. Returns false if memory runs out.
+bool buildCombTable(CombTable* comb, const RuleIndex* dense, int rows, int columns, bool useDefaults);
+
+// Bytes used by the compressed table's arrays.
+size_t combTableBytes(const CombTable* comb);
+
+// Release the arrays of a compressed table.
+void freeCombTable(CombTable* comb);
+
+// Look up a cell of the compressed table.
+static inline RuleIndex combLookup(const CombTable* comb, int row, int column) {
+    CombSlot slot = comb->slots[comb->base[row] + column];
+    return slot.check == row ? slot.next : comb->defaults[row];
+}
+
+#endif
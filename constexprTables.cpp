@@ -0,0 +1,29 @@
+/*
+   ====================================================================
+   Compile-Time Parse Table
+   --------------------------------------------------------------------
+   Instantiates the tables of ll1.hpp for the rule list grammarGen
+   writes from grammar.txt, and hands the dense table to the C parser.
+   Only built for parsers compiled with -DCONSTEXPR_PARSE_TABLE:
+
+     make parserflags=-DCONSTEXPR_PARSE_TABLE
+
+   A conflict in the grammar stops this file from compiling.
+   ====================================================================
+*/
+
+#include "ll1.hpp"
+#include "gen/grammarRules.hpp"
+
+using GrammarTables = ll1::Tables<grammarRules, NT_NOT_FOUND, program>;
+
+extern "C" {
+
+// Table and hash of the grammar it was computed from, for parser.c
+extern const RuleIndex* const constexprRuleTable;
+extern const uint64_t constexprGrammarHash;
+
+const RuleIndex* const constexprRuleTable = GrammarTables::table.data();
+const uint64_t constexprGrammarHash = grammarRulesHash;
+
+}
@@ -85,6 +85,8 @@
 #include <stdlib.h>
 #include "lexer.h"
 #include "parser.h"
+#include "arena.h"
+#include "tokenStream.h"
 #include <time.h>
 
 bool shouldPrint=true;
@@ -98,11 +100,15 @@ int main(int argc, char* argv[]) {
 
     int choice = -1;
 
+    // Cached token stream of the input file
+    char streamPath[4096];
+    snprintf(streamPath, sizeof(streamPath), "%s%s", argv[1], TOKEN_STREAM_EXT);
+
     printf("\nWelcome to our compiler!\n* FIRST and FOLLOW set automated.\n* Both lexical and syntax analysis modules implemented.\n* All modules compile and run without any errors/faults.\n* Our compiler is fully functional!\n");    
 
     while(choice) {
 
-        printf("\nSelect your option:\n 0: To exit\n 1: To remove comments and print on console\n 2: To print tokens list on console\n 3: To parse and print the parse tree\n 4: To print total time taken on console\n");
+        printf("\nSelect your option:\n 0: To exit\n 1: To remove comments and print on console\n 2: To print tokens list on console\n 3: To parse and print the parse tree\n 4: To print total time taken on console\n 5: To save the token stream of the input file\n 6: To parse the saved token stream and print the parse tree\n 7: To parse with the compressed in-memory token stream\n 8: To parse and print the parse tree without epsilon leaves\n");
         scanf("%d", &choice);
         shouldPrint=true;
 
@@ -116,12 +122,14 @@ int main(int argc, char* argv[]) {
                     break;
 
             case 2: {FILE* lexIn = fopen(argv[1], "r");
-                    TokenList* tokens = lexInput(lexIn, argv[2]);
+                    TokenBuffer* tokens = lexInput(lexIn, argv[2], registerSourceFile(argv[1]));
                     displayTokenList(tokens);
+                    freeTokenBuffer(tokens);
+                    resetArena(&compilationArena);
                     fclose(lexIn);
                     break;}
 
-            case 3: parseInputSourceCode(argv[1], argv[2]);
+            case 3: parseInputSourceCode(argv[1], argv[2], NULL);
                     break;
             
             case 4: {clock_t start_time, end_time;
@@ -131,7 +139,7 @@ int main(int argc, char* argv[]) {
 
                     shouldPrint=false;
                     // invoke your lexer and parser here
-                    parseInputSourceCode(argv[1], argv[2]);
+                    parseInputSourceCode(argv[1], argv[2], NULL);
 
                     end_time = clock();
                     total_CPU_time = (double) (end_time - start_time);
@@ -143,6 +151,25 @@ int main(int argc, char* argv[]) {
                     printf("Total CPU time (in seconds): %lf\n",total_CPU_time_in_seconds);
                     break;}
             
+            case 5: {FILE* lexIn = fopen(argv[1], "r");
+                    TokenBuffer* tokens = lexInput(lexIn, argv[2], registerSourceFile(argv[1]));
+                    if (writeTokenStream(tokens, streamPath))
+                        printf("Token stream saved to '%s'\n", streamPath);
+                    freeTokenBuffer(tokens);
+                    resetArena(&compilationArena);
+                    fclose(lexIn);
+                    break;}
+
+            case 6: parseTokenStream(streamPath, argv[2], NULL);
+                    break;
+
+            case 7: parseInputSourceCodePacked(argv[1], argv[2], NULL);
+                    break;
+
+            case 8: {ParseOptions noEpsilonLeaves = { .elideEpsilonLeaves = true };
+                    parseInputSourceCode(argv[1], argv[2], &noEpsilonLeaves);
+                    break;}
+            
             default: printf("Please enter a correct option!\n");
                      break;
         }
@@ -0,0 +1,314 @@
+/*
+   ====================================================================
+   FIRST/FOLLOW Solver Implementation
+   --------------------------------------------------------------------
+   Nullable worklist, dependency graph construction and a single
+   SCC-ordered propagation pass; see firstFollow.h.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "firstFollow.h"
+
+// DependencyGraph: Edges "set of from includes set of to", in CSR form once built.
+typedef struct DependencyGraph {
+    int nodes;          // Number of non-terminals
+    int edges;          // Number of edges added
+    int capacity;       // Capacity of from/to
+    int* from;          // Source of every edge, in insertion order
+    int* to;            // Target of every edge, in insertion order
+    int* edgeStart;     // nodes + 1 offsets into edgeTo
+    int* edgeTo;        // Targets grouped by source
+} DependencyGraph;
+
+// ------------------------- HELPERS -------------------------
+
+static bool addEdge(DependencyGraph* graph, int from, int to) {
+    /*
+       Records that the set of from includes the set of to.
+    */
+    if (from == to)
+        return true;
+    if (graph->edges == graph->capacity) {
+        int newCapacity = graph->capacity ? graph->capacity * 2 : 256;
+        int* grownFrom = (int*) realloc(graph->from, newCapacity * sizeof(int));
+        if (!grownFrom)
+            return false;
+        graph->from = grownFrom;
+        int* grownTo = (int*) realloc(graph->to, newCapacity * sizeof(int));
+        if (!grownTo)
+            return false;
+        graph->to = grownTo;
+        graph->capacity = newCapacity;
+    }
+    graph->from[graph->edges] = from;
+    graph->to[graph->edges] = to;
+    graph->edges++;
+    return true;
+}
+
+static bool buildGraph(DependencyGraph* graph) {
+    /*
+       Groups the edges by source with a counting sort.
+    */
+    graph->edgeStart = (int*) calloc(graph->nodes + 1, sizeof(int));
+    graph->edgeTo = (int*) malloc((graph->edges ? graph->edges : 1) * sizeof(int));
+    if (!graph->edgeStart || !graph->edgeTo)
+        return false;
+    for (int e = 0; e < graph->edges; e++)
+        graph->edgeStart[graph->from[e] + 1]++;
+    for (int v = 0; v < graph->nodes; v++)
+        graph->edgeStart[v + 1] += graph->edgeStart[v];
+    int* fill = (int*) malloc((graph->nodes + 1) * sizeof(int));
+    if (!fill)
+        return false;
+    memcpy(fill, graph->edgeStart, (graph->nodes + 1) * sizeof(int));
+    for (int e = 0; e < graph->edges; e++)
+        graph->edgeTo[fill[graph->from[e]]++] = graph->to[e];
+    free(fill);
+    return true;
+}
+
+static void freeGraph(DependencyGraph* graph) {
+    /*
+       Releases the edge arrays.
+    */
+    free(graph->from);
+    free(graph->to);
+    free(graph->edgeStart);
+    free(graph->edgeTo);
+    memset(graph, 0, sizeof(DependencyGraph));
+}
+
+static bool propagateSets(DependencyGraph* graph, TokenSet* sets) {
+    /*
+       Replaces every seed set by the union of the seeds reachable from it.
+       Tarjan's algorithm, run without recursion, completes components in
+       reverse topological order: when a component is popped, every set it
+       depends on outside of it is already final, so one union per
+       component settles all of its members.
+    */
+    int n = graph->nodes;
+    int* index = (int*) malloc(n * sizeof(int));
+    int* low = (int*) malloc(n * sizeof(int));
+    int* sccStack = (int*) malloc(n * sizeof(int));
+    int* callNode = (int*) malloc(n * sizeof(int));
+    int* callEdge = (int*) malloc(n * sizeof(int));
+    bool* onStack = (bool*) calloc(n, sizeof(bool));
+    if (!index || !low || !sccStack || !callNode || !callEdge || !onStack) {
+        free(index); free(low); free(sccStack); free(callNode); free(callEdge); free(onStack);
+        return false;
+    }
+    for (int v = 0; v < n; v++)
+        index[v] = -1;
+
+    int counter = 0, sccTop = 0;
+    for (int root = 0; root < n; root++) {
+        if (index[root] >= 0)
+            continue;
+        int depth = 0;
+        callNode[0] = root;
+        callEdge[0] = graph->edgeStart[root];
+        index[root] = low[root] = counter++;
+        sccStack[sccTop++] = root;
+        onStack[root] = true;
+
+        while (depth >= 0) {
+            int v = callNode[depth];
+            if (callEdge[depth] < graph->edgeStart[v + 1]) {
+                int w = graph->edgeTo[callEdge[depth]++];
+                if (index[w] < 0) {
+                    // Descend into w
+                    depth++;
+                    callNode[depth] = w;
+                    callEdge[depth] = graph->edgeStart[w];
+                    index[w] = low[w] = counter++;
+                    sccStack[sccTop++] = w;
+                    onStack[w] = true;
+                } else if (onStack[w] && index[w] < low[v]) {
+                    low[v] = index[w];
+                }
+                continue;
+            }
+
+            // All edges of v done; v may close a component
+            if (low[v] == index[v]) {
+                int bottom = sccTop;
+                do {
+                    bottom--;
+                } while (sccStack[bottom] != v);
+
+                // Members still hold their seeds, so OR-ing them in is harmless
+                TokenSet merged = 0;
+                for (int i = bottom; i < sccTop; i++) {
+                    int m = sccStack[i];
+                    merged |= sets[m];
+                    for (int e = graph->edgeStart[m]; e < graph->edgeStart[m + 1]; e++)
+                        merged |= sets[graph->edgeTo[e]];
+                }
+                for (int i = bottom; i < sccTop; i++) {
+                    sets[sccStack[i]] = merged;
+                    onStack[sccStack[i]] = false;
+                }
+                sccTop = bottom;
+            }
+            depth--;
+            if (depth >= 0 && low[v] < low[callNode[depth]])
+                low[callNode[depth]] = low[v];
+        }
+    }
+
+    free(index); free(low); free(sccStack); free(callNode); free(callEdge); free(onStack);
+    return true;
+}
+
+static bool findNullable(const FlatGrammar* grammar, bool* nullable) {
+    /*
+       Marks the non-terminals that derive the empty string. Each rule
+       counts the non-terminals it still waits on before its first
+       terminal; a rule reaching zero makes its left-hand side nullable,
+       which in turn releases the rules that use it.
+    */
+    int rules = grammar->ruleCount, nts = grammar->nonTerminals;
+    int* pending = (int*) malloc((rules ? rules : 1) * sizeof(int));
+    int* useStart = (int*) calloc(nts + 1, sizeof(int));
+    int* useRule = (int*) malloc((grammar->ruleStart[rules] ? grammar->ruleStart[rules] : 1) * sizeof(int));
+    int* queue = (int*) malloc((nts ? nts : 1) * sizeof(int));
+    if (!pending || !useStart || !useRule || !queue) {
+        free(pending); free(useStart); free(useRule); free(queue);
+        return false;
+    }
+
+    // Count the waits of every rule and the uses of every non-terminal
+    for (int r = 0; r < rules; r++) {
+        pending[r] = 0;
+        for (uint32_t i = grammar->ruleStart[r]; i < grammar->ruleStart[r + 1]; i++) {
+            SymbolCode code = grammar->symbols[i];
+            if (!IS_NT_CODE(code)) {
+                if (code != EPS)
+                    pending[r] = -1;   // A real terminal: never nullable, counts only go further down
+                break;
+            }
+            pending[r]++;
+            useStart[CODE_TO_NT(code) + 1]++;
+        }
+    }
+    for (int nt = 0; nt < nts; nt++)
+        useStart[nt + 1] += useStart[nt];
+    int* fill = (int*) malloc((nts + 1) * sizeof(int));
+    if (!fill) {
+        free(pending); free(useStart); free(useRule); free(queue);
+        return false;
+    }
+    memcpy(fill, useStart, (nts + 1) * sizeof(int));
+    for (int r = 0; r < rules; r++) {
+        for (uint32_t i = grammar->ruleStart[r]; i < grammar->ruleStart[r + 1]; i++) {
+            SymbolCode code = grammar->symbols[i];
+            if (!IS_NT_CODE(code))
+                break;
+            useRule[fill[CODE_TO_NT(code)]++] = r;
+        }
+    }
+    free(fill);
+
+    // Seed with the rules that wait on nothing and propagate
+    int head = 0, tail = 0;
+    for (int nt = 0; nt < nts; nt++)
+        nullable[nt] = false;
+    for (int r = 0; r < rules; r++) {
+        int lhs = CODE_TO_NT(grammar->ruleLhs[r]);
+        if (pending[r] == 0 && !nullable[lhs]) {
+            nullable[lhs] = true;
+            queue[tail++] = lhs;
+        }
+    }
+    while (head < tail) {
+        int nt = queue[head++];
+        for (int u = useStart[nt]; u < useStart[nt + 1]; u++) {
+            int r = useRule[u];
+            int lhs = CODE_TO_NT(grammar->ruleLhs[r]);
+            if (--pending[r] == 0 && !nullable[lhs]) {
+                nullable[lhs] = true;
+                queue[tail++] = lhs;
+            }
+        }
+    }
+
+    free(pending); free(useStart); free(useRule); free(queue);
+    return true;
+}
+
+// ------------------------- SOLVER -------------------------
+
+bool solveFirstFollow(const FlatGrammar* grammar, TokenSet* first, TokenSet* follow) {
+    /*
+       FIRST: A depends on every non-terminal that can begin its rules;
+       the terminals that can begin them are its seed.
+       FOLLOW: walking each rule right to left with FIRST of the suffix
+       in hand, a non-terminal is seeded with that FIRST and depends on
+       the left-hand side whenever the suffix can vanish.
+    */
+    int nts = grammar->nonTerminals;
+    bool* nullable = (bool*) malloc((nts ? nts : 1) * sizeof(bool));
+    DependencyGraph graph;
+    memset(&graph, 0, sizeof(graph));
+    graph.nodes = nts;
+    bool ok = nullable && findNullable(grammar, nullable);
+
+    // FIRST sets
+    for (int nt = 0; nt < nts; nt++)
+        first[nt] = 0;
+    for (int r = 0; ok && r < grammar->ruleCount; r++) {
+        int lhs = CODE_TO_NT(grammar->ruleLhs[r]);
+        for (uint32_t i = grammar->ruleStart[r]; ok && i < grammar->ruleStart[r + 1]; i++) {
+            SymbolCode code = grammar->symbols[i];
+            if (!IS_NT_CODE(code)) {
+                if (code != EPS)
+                    first[lhs] |= TOKEN_BIT(code);
+                break;
+            }
+            ok = addEdge(&graph, lhs, CODE_TO_NT(code));
+            if (!nullable[CODE_TO_NT(code)])
+                break;
+        }
+    }
+    ok = ok && buildGraph(&graph) && propagateSets(&graph, first);
+    for (int nt = 0; ok && nt < nts; nt++)
+        if (nullable[nt])
+            first[nt] |= TOKEN_BIT(EPS);
+
+    // FOLLOW sets
+    free(graph.edgeStart);
+    free(graph.edgeTo);
+    graph.edgeStart = graph.edgeTo = NULL;
+    graph.edges = 0;
+    for (int nt = 0; nt < nts; nt++)
+        follow[nt] = 0;
+    if (nts)
+        follow[grammar->startSymbol] |= TOKEN_BIT(DOLLAR);
+    for (int r = 0; ok && r < grammar->ruleCount; r++) {
+        int lhs = CODE_TO_NT(grammar->ruleLhs[r]);
+        TokenSet suffix = TOKEN_BIT(EPS);
+        for (uint32_t i = grammar->ruleStart[r + 1]; ok && i-- > grammar->ruleStart[r];) {
+            SymbolCode code = grammar->symbols[i];
+            if (!IS_NT_CODE(code)) {
+                suffix = TOKEN_BIT(code);
+                continue;
+            }
+            int nt = CODE_TO_NT(code);
+            follow[nt] |= suffix & ~TOKEN_BIT(EPS);
+            if (IN_TOKEN_SET(suffix, EPS))
+                ok = addEdge(&graph, nt, lhs);
+            suffix = (first[nt] & ~TOKEN_BIT(EPS)) | (nullable[nt] ? suffix : 0);
+        }
+    }
+    ok = ok && buildGraph(&graph) && propagateSets(&graph, follow);
+
+    if (!ok)
+        fprintf(stderr, "Memory allocation failed while computing FIRST and FOLLOW sets\n");
+    freeGraph(&graph);
+    free(nullable);
+    return ok;
+}
@@ -0,0 +1,43 @@
+/*
+   ====================================================================
+   FIRST/FOLLOW Solver - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   Computes FIRST and FOLLOW sets of a grammar given in flat form: the
+   symbol codes of every right-hand side laid end to end, with each
+   rule's start offset and left-hand side alongside.
+
+   Instead of sweeping all rules until nothing changes, the solver
+   finds the nullable non-terminals with a worklist, builds the graph
+   of which sets feed which, collapses its strongly connected
+   components (members of a cycle end up with equal sets) and unions
+   the sets once, in topological order. Time is linear in the size of
+   the grammar apart from one word-wide OR per edge.
+
+   A terminal EPS on a right-hand side derives the empty string and
+   ends the sequence, as in grammar.txt.
+   ====================================================================
+*/
+
+#ifndef FIRST_FOLLOW_H
+#define FIRST_FOLLOW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "parserDef.h"
+
+// FlatGrammar: Read-only view of a grammar as symbol code arrays.
+typedef struct FlatGrammar {
+    int ruleCount;                // Number of rules
+    int nonTerminals;             // Non-terminal codes are NT_CODE(0) .. NT_CODE(nonTerminals - 1)
+    int startSymbol;              // Non-terminal whose FOLLOW set holds DOLLAR
+    const uint32_t* ruleStart;    // ruleCount + 1 offsets into symbols
+    const SymbolCode* ruleLhs;    // Left-hand side of every rule
+    const SymbolCode* symbols;    // Right-hand sides, end to end
+} FlatGrammar;
+
+/* ----------- Solver Functions ----------- */
+// Compute FIRST and FOLLOW of every non-terminal into the given arrays
+// of nonTerminals sets each. FIRST holds EPS for nullable non-terminals.
+bool solveFirstFollow(const FlatGrammar* grammar, TokenSet* first, TokenSet* follow);
+
+#endif
@@ -0,0 +1,348 @@
+/*
+   ====================================================================
+   Parse Table Cache Implementation
+   --------------------------------------------------------------------
+   Serializes the compiled rules, FIRST/FOLLOW sets, parse table and
+   unit chains to a .lltab file, and serves them straight from the
+   mapped file without reading the grammar or running any fixpoint.
+   See grammarCache.h for the file layout.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lexer.h"
+#include "parser.h"
+#include "parserDef.h"
+#include "arena.h"
+#include "grammarCache.h"
+
+// ------------------------- HELPERS -------------------------
+
+// Cache file the loaded tables point into, unmapped when they are discarded
+static char* mappedCache = NULL;
+static size_t mappedCacheSize = 0;
+
+static uint64_t alignUp(uint64_t offset, uint64_t alignment) {
+    /*
+       Rounds an offset up to the next multiple of a power of two.
+    */
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+static uint32_t unitChainLength() {
+    /*
+       Returns the number of entries of unitChainRules in use: the unused
+       slot 0 and every chain, each its length followed by its rules.
+    */
+    uint32_t length = 1;
+    for (int cell = 0; cell < NT_NOT_FOUND * TK_NOT_FOUND; cell++) {
+        uint32_t chain = unitChainStart[cell];
+        if (chain && chain + 1 + unitChainRules[chain] > length)
+            length = chain + 1 + unitChainRules[chain];
+    }
+    return length;
+}
+
+static bool cacheFilePath(char* path, size_t size, uint64_t grammarHash) {
+    /*
+       Builds the path of the grammar's cache file in the user's cache
+       directory, creating the directory when needed. Returns false when
+       there is no cache directory, in which case nothing is cached.
+    */
+    char dir[4096];
+    const char* xdg = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (xdg && *xdg)
+        snprintf(dir, sizeof(dir), "%s", xdg);
+    else if (home && *home)
+        snprintf(dir, sizeof(dir), "%s/.cache", home);
+    else
+        return false;
+
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        return false;
+    size_t length = strlen(dir);
+    snprintf(dir + length, sizeof(dir) - length, "/%s", LLTAB_DIR);
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        return false;
+    return snprintf(path, size, "%s/%016" PRIx64 LLTAB_EXT, dir, grammarHash) < (int) size;
+}
+
+static void discardGrammarTables() {
+    /*
+       Forgets the loaded tables so they can be replaced. Tables built at
+       runtime live in the grammar arena and are released with it; tables
+       served from a cache file are released by unmapping it.
+    */
+    grammarLoaded = false;
+    firstFollowComputed = false;
+    parseTreeInitialized = false;
+    numOfRules = 0;
+    Grammar = NULL;
+    parseTable = NULL;
+    compiledRules = NULL;
+    ruleTable = NULL;
+    AutoFirst = NULL;
+    AutoFollow = NULL;
+    unitChainStart = NULL;
+    unitChainRules = NULL;
+    loadedGrammarHash = 0;
+    resetArena(&grammarArena);
+    if (mappedCache) {
+        munmap(mappedCache, mappedCacheSize);
+        mappedCache = NULL;
+        mappedCacheSize = 0;
+    }
+}
+
+// ------------------------- WRITER -------------------------
+
+bool writeGrammarCache(const char* path, uint64_t grammarHash) {
+    /*
+       Writes the loaded tables to a temporary file and renames it over
+       the target, so that concurrent readers never see a partial cache.
+    */
+    if (!firstFollowComputed || !parseTreeInitialized || !compiledRules || !unitChainStart)
+        return false;
+    if (numOfRules > INT16_MAX)
+        return false;
+
+    uint32_t symbolCount = 0;
+    for (int r = 0; r < numOfRules; r++)
+        symbolCount += (uint32_t) compiledRules[r].length;
+
+    LLTableHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LLTAB_MAGIC, 4);
+    header.version = LLTAB_VERSION;
+    header.headerSize = sizeof(LLTableHeader);
+    header.grammarHash = grammarHash;
+    header.ruleCount = (uint32_t) numOfRules;
+    header.symbolCount = symbolCount;
+    header.nonTerminals = NT_NOT_FOUND;
+    header.tokens = TK_NOT_FOUND;
+    header.unitChainLength = unitChainLength();
+    header.ruleLhsOffset = alignUp(sizeof(LLTableHeader), 8);
+    header.ruleStartOffset = alignUp(header.ruleLhsOffset + header.ruleCount * sizeof(SymbolCode), 8);
+    header.codesOffset = alignUp(header.ruleStartOffset + (header.ruleCount + 1) * sizeof(uint32_t), 8);
+    header.firstOffset = alignUp(header.codesOffset + 2 * (uint64_t) symbolCount * sizeof(SymbolCode), 8);
+    header.followOffset = header.firstOffset + NT_NOT_FOUND * sizeof(TokenSet);
+    header.tableOffset = alignUp(header.followOffset + NT_NOT_FOUND * sizeof(TokenSet), PARSE_TABLE_ALIGN);
+    header.unitStartOffset = alignUp(header.tableOffset + NT_NOT_FOUND * TK_NOT_FOUND * sizeof(RuleIndex), 8);
+    header.unitRulesOffset = header.unitStartOffset + NT_NOT_FOUND * TK_NOT_FOUND * sizeof(uint32_t);
+    uint64_t fileSize = header.unitRulesOffset + header.unitChainLength * sizeof(RuleIndex);
+
+    // Build the whole image in memory; it is only a few KB
+    char* image = (char*) calloc(1, fileSize);
+    if (!image) {
+        fprintf(stderr, "Memory allocation failed for the parse table cache\n");
+        return false;
+    }
+    memcpy(image, &header, sizeof(header));
+    SymbolCode* ruleLhs = (SymbolCode*)(image + header.ruleLhsOffset);
+    uint32_t* ruleStart = (uint32_t*)(image + header.ruleStartOffset);
+    SymbolCode* codes = (SymbolCode*)(image + header.codesOffset);
+
+    uint32_t next = 0;
+    for (int r = 0; r < numOfRules; r++) {
+        const CompiledRule* cr = &compiledRules[r];
+        ruleLhs[r] = NT_CODE(cr->lhs);
+        ruleStart[r] = next;
+        memcpy(codes + 2 * next, cr->rhs, cr->length * sizeof(SymbolCode));
+        memcpy(codes + 2 * next + cr->length, cr->push, cr->length * sizeof(SymbolCode));
+        next += (uint32_t) cr->length;
+    }
+    ruleStart[numOfRules] = next;
+    memcpy(image + header.firstOffset, AutoFirst, NT_NOT_FOUND * sizeof(TokenSet));
+    memcpy(image + header.followOffset, AutoFollow, NT_NOT_FOUND * sizeof(TokenSet));
+    memcpy(image + header.tableOffset, ruleTable, NT_NOT_FOUND * TK_NOT_FOUND * sizeof(RuleIndex));
+    memcpy(image + header.unitStartOffset, unitChainStart, NT_NOT_FOUND * TK_NOT_FOUND * sizeof(uint32_t));
+    memcpy(image + header.unitRulesOffset, unitChainRules, header.unitChainLength * sizeof(RuleIndex));
+
+    char tmpPath[4096 + 32];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", path, (int) getpid());
+    FILE* fp = fopen(tmpPath, "wb");
+    bool ok = fp && fwrite(image, 1, fileSize, fp) == fileSize;
+    if (fp && fclose(fp) != 0)
+        ok = false;
+    free(image);
+    if (!ok || rename(tmpPath, path) != 0) {
+        fprintf(stderr, "Could not write the parse table cache %s\n", path);
+        remove(tmpPath);
+        return false;
+    }
+    return true;
+}
+
+// ------------------------- READER -------------------------
+
+static bool validCache(const char* base, size_t size, uint64_t grammarHash) {
+    /*
+       Checks the header, the section bounds and alignment, and every
+       stored symbol code, rule index and unit chain, since the parser
+       will index its arrays with them without further checks.
+    */
+    const LLTableHeader* header = (const LLTableHeader*) base;
+    if (size < sizeof(LLTableHeader)
+        || memcmp(header->magic, LLTAB_MAGIC, 4) != 0
+        || header->version != LLTAB_VERSION
+        || header->headerSize != sizeof(LLTableHeader)
+        || header->grammarHash != grammarHash
+        || header->nonTerminals != NT_NOT_FOUND
+        || header->tokens != TK_NOT_FOUND
+        || header->ruleCount > INT16_MAX
+        || header->unitChainLength == 0
+        || header->ruleLhsOffset % 8 || header->ruleStartOffset % 8 || header->codesOffset % 8
+        || header->firstOffset % 8 || header->followOffset % 8 || header->unitStartOffset % 8
+        || header->unitRulesOffset % 8 || header->tableOffset % PARSE_TABLE_ALIGN
+        || header->ruleLhsOffset + (uint64_t) header->ruleCount * sizeof(SymbolCode) > size
+        || header->ruleStartOffset + ((uint64_t) header->ruleCount + 1) * sizeof(uint32_t) > size
+        || header->codesOffset + 2 * (uint64_t) header->symbolCount * sizeof(SymbolCode) > size
+        || header->firstOffset + NT_NOT_FOUND * sizeof(TokenSet) > size
+        || header->followOffset + NT_NOT_FOUND * sizeof(TokenSet) > size
+        || header->tableOffset + NT_NOT_FOUND * TK_NOT_FOUND * sizeof(RuleIndex) > size
+        || header->unitStartOffset + NT_NOT_FOUND * TK_NOT_FOUND * sizeof(uint32_t) > size
+        || header->unitRulesOffset + (uint64_t) header->unitChainLength * sizeof(RuleIndex) > size)
+        return false;
+
+    const SymbolCode* ruleLhs = (const SymbolCode*)(base + header->ruleLhsOffset);
+    const uint32_t* ruleStart = (const uint32_t*)(base + header->ruleStartOffset);
+    const SymbolCode* codes = (const SymbolCode*)(base + header->codesOffset);
+    const RuleIndex* table = (const RuleIndex*)(base + header->tableOffset);
+    const uint32_t* unitStart = (const uint32_t*)(base + header->unitStartOffset);
+    const RuleIndex* unitRules = (const RuleIndex*)(base + header->unitRulesOffset);
+
+    // Rules: lengths add up, symbols are known, push orders are the reversed rhs
+    if (ruleStart[0] != 0 || ruleStart[header->ruleCount] != header->symbolCount)
+        return false;
+    for (uint32_t r = 0; r < header->ruleCount; r++) {
+        if (ruleStart[r] >= ruleStart[r + 1] || !IS_NT_CODE(ruleLhs[r]) || ruleLhs[r] >= SYMBOL_CODE_COUNT)
+            return false;
+        uint32_t length = ruleStart[r + 1] - ruleStart[r];
+        const SymbolCode* rhs = codes + 2 * ruleStart[r];
+        for (uint32_t i = 0; i < length; i++)
+            if (rhs[i] >= SYMBOL_CODE_COUNT || rhs[length + i] != rhs[length - 1 - i])
+                return false;
+    }
+
+    // Cells hold rule indices; chains hold a length of at least one and rule indices
+    for (int cell = 0; cell < NT_NOT_FOUND * TK_NOT_FOUND; cell++) {
+        if (table[cell] > header->ruleCount)
+            return false;
+        uint32_t chain = unitStart[cell];
+        if (!chain)
+            continue;
+        if (chain >= header->unitChainLength || unitRules[chain] == 0
+            || (uint64_t) chain + unitRules[chain] >= header->unitChainLength)
+            return false;
+        for (uint32_t k = 1; k <= unitRules[chain]; k++)
+            if (unitRules[chain + k] == NO_RULE || unitRules[chain + k] > header->ruleCount)
+                return false;
+    }
+    return true;
+}
+
+bool mapGrammarCache(const char* path, uint64_t grammarHash) {
+    /*
+       Maps the cache file and points the parser's tables into it. Only
+       the CompiledRule array, a few bytes per rule, is allocated. Nothing
+       is changed unless the whole file validates.
+    */
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    size_t size = (size_t) st.st_size;
+    char* base = size ? (char*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0) : (char*) MAP_FAILED;
+    close(fd);
+    if (base == MAP_FAILED)
+        return false;
+    if (!validCache(base, size, grammarHash)) {
+        fprintf(stderr, "Ignoring stale or corrupt parse table cache %s\n", path);
+        munmap(base, size);
+        return false;
+    }
+
+    const LLTableHeader* header = (const LLTableHeader*) base;
+    const SymbolCode* ruleLhs = (const SymbolCode*)(base + header->ruleLhsOffset);
+    const uint32_t* ruleStart = (const uint32_t*)(base + header->ruleStartOffset);
+    const SymbolCode* codes = (const SymbolCode*)(base + header->codesOffset);
+
+    // Compiled rules refer to their codes in the mapping
+    numOfRules = (int) header->ruleCount;
+    compiledRules = (CompiledRule*) arenaAlloc(&grammarArena, (numOfRules + 1) * sizeof(CompiledRule));
+    for (int r = 0; r < numOfRules; r++) {
+        CompiledRule* cr = &compiledRules[r];
+        cr->lhs = (NonTerminal) CODE_TO_NT(ruleLhs[r]);
+        cr->length = (int)(ruleStart[r + 1] - ruleStart[r]);
+        cr->rhs = codes + 2 * ruleStart[r];
+        cr->push = cr->rhs + cr->length;
+    }
+
+    // Everything else is used in place; the mapping is read-only
+    AutoFirst = (TokenSet*)(base + header->firstOffset);
+    AutoFollow = (TokenSet*)(base + header->followOffset);
+    ruleTable = (RuleIndex*)(base + header->tableOffset);
+    unitChainStart = (uint32_t*)(base + header->unitStartOffset);
+    unitChainRules = (RuleIndex*)(base + header->unitRulesOffset);
+    firstFollowComputed = true;
+    parseTreeInitialized = true;
+
+    mappedCache = base;
+    mappedCacheSize = size;
+    return true;
+}
+
+// ------------------------- LOADING -------------------------
+
+bool loadGrammarTables(const char* grammarPath) {
+    /*
+       Hashes the grammar file and makes its tables current. When the file
+       cannot be read the tables already loaded (such as those generated at
+       build time) stay in use; when it is read but cannot be loaded as a
+       grammar, no tables remain and false is returned. Without a cache
+       directory the grammar is analyzed every time.
+    */
+    uint64_t grammarHash = hashGrammarFile(grammarPath);
+    if (!grammarHash) {
+        if (parseTreeInitialized)
+            return true;
+        fprintf(stderr, "Could not read grammar file %s\n", grammarPath);
+        return false;
+    }
+    if (parseTreeInitialized && grammarHash == loadedGrammarHash)
+        return true;
+
+    discardGrammarTables();
+
+    char cachePath[4096];
+    bool cacheable = cacheFilePath(cachePath, sizeof(cachePath), grammarHash);
+    if (!cacheable || !mapGrammarCache(cachePath, grammarHash)) {
+        // Tables of a grammar that failed to load must neither be used nor cached
+        if (!readGrammar(grammarPath)) {
+            fprintf(stderr, "Could not build parse tables from grammar file %s\n", grammarPath);
+            discardGrammarTables();
+            return false;
+        }
+        initializeAndComputeFirstAndFollow();
+        initializeParseTable();
+        if (cacheable)
+            writeGrammarCache(cachePath, grammarHash);
+    }
+    loadedGrammarHash = grammarHash;
+    if (debugPrint)
+        printf("Using parse tables for grammar %016" PRIx64 "\n", grammarHash);
+    return true;
+}
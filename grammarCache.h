@@ -0,0 +1,74 @@
+/*
+   ====================================================================
+   Parse Table Cache - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   Grammars can be swapped without rebuilding, so the analysis results
+   are cached on disk in a file named after the grammar's hash, in the
+   user's cache directory:
+
+     $XDG_CACHE_HOME/stage1/<16 hex digits>.lltab
+     (~/.cache/stage1/ when XDG_CACHE_HOME is not set)
+
+   Layout (all offsets from the start of the file, 8-byte aligned):
+
+     header | rule lhs | rule starts | rhs and push codes |
+     FIRST bitsets | FOLLOW bitsets | parse table | unit chains
+
+   Every section after the rules is stored exactly as the parser reads
+   it: sets as one TokenSet per non-terminal, the parse table as dense
+   rule indices (aligned to PARSE_TABLE_ALIGN) and the unit chains as
+   unitChainStart and unitChainRules. The mapping stays open and the
+   tables point into it; only the CompiledRule array is built on load.
+   ====================================================================
+*/
+
+#ifndef GRAMMAR_CACHE_H
+#define GRAMMAR_CACHE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "parserDef.h"
+
+/* Constant Definitions */
+#define LLTAB_MAGIC     "LLTB"     // First four bytes of every cache file
+#define LLTAB_VERSION   2          // Bumped on every layout change
+#define LLTAB_EXT       ".lltab"   // Extension of cache files
+#define LLTAB_DIR       "stage1"   // Directory of cache files inside the user's cache directory
+
+// LLTableHeader: Fixed header at the start of a cache file.
+typedef struct LLTableHeader {
+    char magic[4];            // LLTAB_MAGIC
+    uint16_t version;         // LLTAB_VERSION
+    uint16_t headerSize;      // sizeof(LLTableHeader)
+    uint64_t grammarHash;     // hashGrammarFile() of the grammar the tables belong to
+    uint32_t ruleCount;       // Number of rules
+    uint32_t symbolCount;     // Total right-hand side symbols
+    uint16_t nonTerminals;    // NT_NOT_FOUND when written
+    uint16_t tokens;          // TK_NOT_FOUND when written
+    uint32_t unitChainLength; // Entries of unitChainRules, the unused slot 0 included
+    uint64_t ruleLhsOffset;   // SymbolCode per rule
+    uint64_t ruleStartOffset; // uint32_t per rule plus one: rhs symbols before each rule
+    uint64_t codesOffset;     // Per rule, its rhs then its push order (2 x symbolCount codes)
+    uint64_t firstOffset;     // TokenSet per non-terminal
+    uint64_t followOffset;    // TokenSet per non-terminal
+    uint64_t tableOffset;     // RuleIndex per [non-terminal][token] cell, as ruleTable
+    uint64_t unitStartOffset; // uint32_t per cell, as unitChainStart
+    uint64_t unitRulesOffset; // RuleIndex per entry, as unitChainRules
+} LLTableHeader;
+
+/* ----------- Cache Functions ----------- */
+// Make the tables of the given grammar file current: keep them if already
+// loaded, else map its cache file, else analyze the grammar and write one.
+// Returns false, with no tables loaded, if the grammar cannot be loaded.
+bool loadGrammarTables(const char* grammarPath);
+
+// Write the currently loaded tables to a cache file; the file is replaced atomically.
+bool writeGrammarCache(const char* path, uint64_t grammarHash);
+
+// Point the tables at a cache file if it exists and matches the hash. The
+// file stays mapped while they are in use; Grammar and parseTable are not
+// rebuilt (grammarLoaded stays false), so readGrammar() can still fill them.
+bool mapGrammarCache(const char* path, uint64_t grammarHash);
+
+#endif
@@ -0,0 +1,313 @@
+/*
+   ====================================================================
+   Grammar Table Generator
+   --------------------------------------------------------------------
+   Build-time tool that runs the parser's own grammar analysis once
+   (readGrammar(), FIRST/FOLLOW fixpoints, parse table construction)
+   and writes the results as statically initialized C data. A parser
+   compiled with -DSTATIC_GRAMMAR_TABLES links that file instead of
+   doing any of this work at startup.
+
+   Usage: grammarGen <output.c> [rules.hpp]      (reads grammar.txt like the parser)
+
+   The optional second output is the grammar as a constexpr rule list
+   for the compile-time tables of ll1.hpp.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "lexer.h"
+#include "parser.h"
+#include "parserDef.h"
+
+// ------------------------- EMITTERS -------------------------
+
+static void emitSymbolUnit(FILE* out, SymbolUnit* su) {
+    /*
+       Writes one SymbolUnit initializer, naming the symbol in a comment.
+    */
+    if (su->isNonTerminal)
+        fprintf(out, "    { true, { .nt = (NonTerminal) %d } },   /* %s */\n",
+                su->value.nt, nonTerminalToString[su->value.nt]);
+    else
+        fprintf(out, "    { false, { .t = (Token) %d } },   /* %s */\n",
+                su->value.t, tokenToString[su->value.t]);
+}
+
+static void emitRules(FILE* out) {
+    /*
+       Rules become four flat arrays: the symbols (left-hand sides first,
+       then every right-hand side in order), the list nodes linking the
+       right-hand sides, the lists themselves and the rules.
+    */
+    int symbolCount = 0;
+    for (int r = 0; r < numOfRules; r++)
+        symbolCount += Grammar[r]->rhs->count;
+
+    fprintf(out, "static SymbolUnit grammarSymbols[%d] = {\n", numOfRules + symbolCount);
+    for (int r = 0; r < numOfRules; r++)
+        emitSymbolUnit(out, Grammar[r]->lhs);
+    for (int r = 0; r < numOfRules; r++) {
+        for (SymbolNode* sn = Grammar[r]->rhs->head; sn; sn = sn->next)
+            emitSymbolUnit(out, sn->symbol);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static SymbolNode grammarNodes[%d] = {\n", symbolCount ? symbolCount : 1);
+    int node = 0;
+    for (int r = 0; r < numOfRules; r++) {
+        int count = Grammar[r]->rhs->count;
+        for (int k = 0; k < count; k++, node++) {
+            fprintf(out, "    { &grammarSymbols[%d], ", numOfRules + node);
+            if (k > 0) fprintf(out, "&grammarNodes[%d], ", node - 1);
+            else fprintf(out, "NULL, ");
+            if (k < count - 1) fprintf(out, "&grammarNodes[%d] },\n", node + 1);
+            else fprintf(out, "NULL },\n");
+        }
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static SymbolList grammarRhs[%d] = {\n", numOfRules);
+    node = 0;
+    for (int r = 0; r < numOfRules; r++) {
+        int count = Grammar[r]->rhs->count;
+        if (count)
+            fprintf(out, "    { &grammarNodes[%d], &grammarNodes[%d], %d },\n", node, node + count - 1, count);
+        else
+            fprintf(out, "    { NULL, NULL, 0 },\n");
+        node += count;
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static GrammarRule grammarRules[%d] = {\n", numOfRules);
+    for (int r = 0; r < numOfRules; r++)
+        fprintf(out, "    { &grammarSymbols[%d], &grammarRhs[%d] },\n", r, r);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static GrammarRule* grammarRulePointers[%d] = {\n", numOfRules);
+    for (int r = 0; r < numOfRules; r++)
+        fprintf(out, "    &grammarRules[%d],\n", r);
+    fprintf(out, "};\n");
+    fprintf(out, "GrammarRule** Grammar = grammarRulePointers;\n");
+    fprintf(out, "int numOfRules = %d;\n\n", numOfRules);
+}
+
+static void emitCompiledRules(FILE* out) {
+    /*
+       Writes the compiled rules over one array holding, for each rule,
+       its right-hand side followed by the same symbols reversed.
+    */
+    int codeCount = 0;
+    for (int r = 0; r < numOfRules; r++)
+        codeCount += 2 * compiledRules[r].length;
+
+    fprintf(out, "static const SymbolCode compiledSymbols[%d] = {\n", codeCount ? codeCount : 1);
+    for (int r = 0; r < numOfRules; r++) {
+        CompiledRule* cr = &compiledRules[r];
+        if (!cr->length)
+            continue;
+        fprintf(out, "   ");
+        for (int i = 0; i < cr->length; i++)
+            fprintf(out, " %d,", cr->rhs[i]);
+        fprintf(out, " ");
+        for (int i = 0; i < cr->length; i++)
+            fprintf(out, " %d,", cr->push[i]);
+        fprintf(out, "   /* %s */\n", nonTerminalToString[cr->lhs]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static CompiledRule compiledRuleArray[%d] = {\n", numOfRules);
+    int code = 0;
+    for (int r = 0; r < numOfRules; r++) {
+        CompiledRule* cr = &compiledRules[r];
+        fprintf(out, "    { (NonTerminal) %d, %d, &compiledSymbols[%d], &compiledSymbols[%d] },\n",
+                cr->lhs, cr->length, code, code + cr->length);
+        code += 2 * cr->length;
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emitUnitChains(FILE* out) {
+    /*
+       Writes the chain offset of every cell and the chains themselves.
+    */
+    uint32_t total = 1;
+    fprintf(out, "static uint32_t unitChainCells[NT_NOT_FOUND * TK_NOT_FOUND] = {\n");
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        fprintf(out, "    /* %s */\n   ", nonTerminalToString[nt]);
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            uint32_t chain = UNIT_CHAIN_CELL(nt, tk);
+            fprintf(out, " %u,", chain);
+            if (tk % 16 == 15) fprintf(out, "\n   ");
+            if (chain && chain + 1 + unitChainRules[chain] > total)
+                total = chain + 1 + unitChainRules[chain];
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static RuleIndex unitChainList[%u] = {\n    0,\n", total);
+    for (uint32_t chain = 1; chain < total; chain += 1 + unitChainRules[chain]) {
+        fprintf(out, "    %d,", unitChainRules[chain]);
+        for (int k = 1; k <= unitChainRules[chain]; k++)
+            fprintf(out, " %d,", unitChainRules[chain + k]);
+        fprintf(out, "\n");
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emitSets(FILE* out, const char* name, TokenSet* sets) {
+    /*
+       Writes the sets of every non-terminal as one token bitset each.
+    */
+    fprintf(out, "static TokenSet %sSets[NT_NOT_FOUND] = {\n", name);
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++)
+        fprintf(out, "    0x%016" PRIx64 "ULL,   /* %s */\n", sets[nt], nonTerminalToString[nt]);
+    fprintf(out, "};\n\n");
+}
+
+static void emitParseTable(FILE* out) {
+    /*
+       Writes the table as one row array per non-terminal; cells hold the
+       address of the rule to expand, or NULL for an error entry.
+    */
+    fprintf(out, "static GrammarRule* parseTableCells[NT_NOT_FOUND][TK_NOT_FOUND] = {\n");
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        fprintf(out, "    {   /* %s */\n       ", nonTerminalToString[nt]);
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            int index = RULE_TABLE_CELL(nt, tk) - 1;
+            if (index >= 0) fprintf(out, " &grammarRules[%d],", index);
+            else fprintf(out, " NULL,");
+            if (tk % 8 == 7) fprintf(out, "\n       ");
+        }
+        fprintf(out, "\n    },\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static GrammarRule** parseTableRows[NT_NOT_FOUND] = {\n");
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++)
+        fprintf(out, "    parseTableCells[%d],\n", nt);
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static _Alignas(PARSE_TABLE_ALIGN) RuleIndex ruleTableCells[NT_NOT_FOUND * TK_NOT_FOUND] = {\n");
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        fprintf(out, "    /* %s */\n   ", nonTerminalToString[nt]);
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            fprintf(out, " %d,", RULE_TABLE_CELL(nt, tk));
+            if (tk % 16 == 15) fprintf(out, "\n   ");
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "};\n\n");
+}
+
+static bool emitConstexprRules(const char* path) {
+    /*
+       Writes every rule as an ll1::rule() call over its symbols; the C++
+       compiler derives the tables from this list.
+    */
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Could not open %s for writing\n", path);
+        return false;
+    }
+    fprintf(out, "/*\n   Generated by grammarGen from grammar.txt - do not edit.\n"
+                 "   The grammar as a constexpr rule list for ll1.hpp.\n*/\n\n");
+    fprintf(out, "#ifndef GRAMMAR_RULES_HPP\n#define GRAMMAR_RULES_HPP\n\n");
+    fprintf(out, "#include \"ll1.hpp\"\n\n");
+    fprintf(out, "// FNV-1a hash of the grammar file the rules were generated from\n");
+    fprintf(out, "inline constexpr uint64_t grammarRulesHash = 0x%016" PRIx64 "ULL;\n\n", hashGrammarFile(GRAMMAR_FILE));
+    fprintf(out, "inline constexpr ll1::Rule grammarRules[] = {\n");
+    for (int r = 0; r < numOfRules; r++) {
+        // Symbols are written by value, as enum names do not always match
+        // the grammar's; the rule follows as written in the grammar
+        fprintf(out, "    ll1::rule((NonTerminal) %d", Grammar[r]->lhs->value.nt);
+        for (SymbolNode* sn = Grammar[r]->rhs->head; sn; sn = sn->next) {
+            if (sn->symbol->isNonTerminal)
+                fprintf(out, ", (NonTerminal) %d", sn->symbol->value.nt);
+            else
+                fprintf(out, ", (Token) %d", sn->symbol->value.t);
+        }
+        fprintf(out, "),   // %s", nonTerminalToString[Grammar[r]->lhs->value.nt]);
+        for (SymbolNode* sn = Grammar[r]->rhs->head; sn; sn = sn->next) {
+            if (sn->symbol->isNonTerminal)
+                fprintf(out, " %s", nonTerminalToString[sn->symbol->value.nt]);
+            else
+                fprintf(out, " %s", tokenToString[sn->symbol->value.t] + 3);
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "};\n\n#endif\n");
+    return fclose(out) == 0;
+}
+
+// ------------------------- MAIN -------------------------
+
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        fprintf(stderr, "Usage: %s <output.c> [rules.hpp]\n", argv[0]);
+        return 1;
+    }
+
+    // Run the same analysis the parser runs at startup
+    initTokenStrings();
+    initializeNonTerminalToString();
+    if (!readGrammar(GRAMMAR_FILE) || numOfRules == 0) {
+        fprintf(stderr, "No grammar rules read; nothing to generate\n");
+        return 1;
+    }
+    initializeAndComputeFirstAndFollow();
+    initializeParseTable();
+
+    FILE* out = fopen(argv[1], "w");
+    if (!out) {
+        fprintf(stderr, "Could not open %s for writing\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "/*\n   Generated by grammarGen from grammar.txt - do not edit.\n"
+                 "   Statically initialized grammar, FIRST/FOLLOW sets and parse table\n"
+                 "   for a parser compiled with -DSTATIC_GRAMMAR_TABLES.\n*/\n\n");
+    fprintf(out, "#include \"parserDef.h\"\n\n");
+    fprintf(out, "// FNV-1a hash of the grammar file the tables were generated from\n");
+    fprintf(out, "const uint64_t staticGrammarHash = 0x%016" PRIx64 "ULL;\n\n", hashGrammarFile(GRAMMAR_FILE));
+
+    fprintf(out, "char* nonTerminalToString[NT_NOT_FOUND] = {\n");
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++)
+        fprintf(out, "    \"%s\",\n", nonTerminalToString[nt]);
+    fprintf(out, "};\n\n");
+
+    emitRules(out);
+    emitCompiledRules(out);
+    emitUnitChains(out);
+    emitSets(out, "first", AutoFirst);
+    emitSets(out, "follow", AutoFollow);
+    emitParseTable(out);
+
+    fprintf(out, "TokenSet* First = NULL;\n");
+    fprintf(out, "TokenSet* Follow = NULL;\n");
+    fprintf(out, "TokenSet* AutoFirst = firstSets;\n");
+    fprintf(out, "TokenSet* AutoFollow = followSets;\n");
+    fprintf(out, "GrammarRule*** parseTable = parseTableRows;\n");
+    fprintf(out, "RuleIndex* ruleTable = ruleTableCells;\n");
+    fprintf(out, "CompiledRule* compiledRules = compiledRuleArray;\n");
+    fprintf(out, "uint32_t* unitChainStart = unitChainCells;\n");
+    fprintf(out, "RuleIndex* unitChainRules = unitChainList;\n\n");
+    fprintf(out, "// Everything above is ready before main() runs\n");
+    fprintf(out, "bool grammarLoaded = true;\n");
+    fprintf(out, "bool nonTerminalsInitialized = true;\n");
+    fprintf(out, "bool firstFollowComputed = true;\n");
+    fprintf(out, "bool parseTreeInitialized = true;\n");
+    fprintf(out, "uint64_t loadedGrammarHash = 0x%016" PRIx64 "ULL;\n", hashGrammarFile(GRAMMAR_FILE));
+
+    if (fclose(out) != 0) {
+        fprintf(stderr, "Could not write %s\n", argv[1]);
+        return 1;
+    }
+    if (argc == 3 && !emitConstexprRules(argv[2]))
+        return 1;
+    printf("Generated %s: %d rules, %d non-terminals\n", argv[1], numOfRules, (int) NT_NOT_FOUND);
+    return 0;
+}
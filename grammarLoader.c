@@ -0,0 +1,500 @@
+/*
+   ====================================================================
+   Grammar Loader Implementation
+   --------------------------------------------------------------------
+   Line reader, hashed name resolution and per-grammar analysis for
+   the loader described in grammarLoader.h. A grammar is read into
+   growable arrays first and copied into its own arena once complete,
+   so a loaded grammar is one arena and can be released as a whole.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lexer.h"
+#include "grammarLoader.h"
+#include "firstFollow.h"
+
+/* Constant Definitions */
+#define TOKEN_NAME_SLOTS   256   // Slots of the terminal name table (a power of two above 2 * TK_NOT_FOUND)
+#define MIN_NAME_SLOTS     64    // Initial slots of a non-terminal name table
+
+// GrammarBuilder: A grammar while it is being read.
+typedef struct GrammarBuilder {
+    const char* name;          // Source name for error messages
+    int line;                  // Line being read
+    int ruleCount;             // Rules read so far
+    int ruleCapacity;          // Capacity of ruleStart and ruleLhs
+    uint32_t* ruleStart;       // First symbol of every rule, plus one past the end
+    SymbolCode* ruleLhs;       // Left-hand side of every rule
+    uint32_t symbolCount;      // Right-hand side symbols read so far
+    uint32_t symbolCapacity;   // Capacity of symbols
+    SymbolCode* symbols;       // Right-hand sides, end to end
+    int nonTerminals;          // Distinct non-terminals seen so far
+    int ntCapacity;            // Capacity of ntName and ntLength
+    const char** ntName;       // Name of every non-terminal, pointing into the text
+    uint32_t* ntLength;        // Length of every name
+    uint32_t nameMask;         // Slots of nameSlots minus one
+    int32_t* nameSlots;        // Non-terminal index + 1, 0 when free
+} GrammarBuilder;
+
+// Grammars loaded so far, most recent first
+static LoadedGrammar* loadedGrammars = NULL;
+
+// Terminal names (without TK_) by hash; token + 1, 0 when free
+static int16_t tokenSlots[TOKEN_NAME_SLOTS];
+static bool tokenSlotsBuilt = false;
+
+// ------------------------- HELPERS -------------------------
+
+static uint32_t hashName(const char* name, size_t length) {
+    /*
+       32-bit FNV-1a hash of a symbol name.
+    */
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char) name[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint64_t hashText(const char* text, size_t length) {
+    /*
+       64-bit FNV-1a hash of a whole grammar, matching hashGrammarFile().
+    */
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char) text[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool growArray(void** array, int* capacity, int needed, size_t itemSize) {
+    /*
+       Doubles the capacity of a malloc'ed array until needed items fit.
+    */
+    if (needed <= *capacity)
+        return true;
+    int newCapacity = *capacity ? *capacity : 64;
+    while (newCapacity < needed)
+        newCapacity *= 2;
+    void* grown = realloc(*array, (size_t) newCapacity * itemSize);
+    if (!grown) {
+        fprintf(stderr, "Memory allocation failed while reading a grammar\n");
+        return false;
+    }
+    *array = grown;
+    *capacity = newCapacity;
+    return true;
+}
+
+static void buildTokenSlots() {
+    /*
+       Hashes the name of every token once. Grammars name terminals without
+       the TK_ prefix, so only tokens that have one can appear in a rule.
+    */
+    if (tokenSlotsBuilt)
+        return;
+    tokenSlotsBuilt = true;
+    initTokenStrings();
+    for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+        const char* name = tokenToString[tk];
+        if (strncmp(name, "TK_", 3) != 0)
+            continue;
+        uint32_t slot = hashName(name + 3, strlen(name + 3)) & (TOKEN_NAME_SLOTS - 1);
+        while (tokenSlots[slot])
+            slot = (slot + 1) & (TOKEN_NAME_SLOTS - 1);
+        tokenSlots[slot] = (int16_t)(tk + 1);
+    }
+}
+
+static Token lookupGrammarToken(const char* name, size_t length) {
+    /*
+       Resolves a terminal name of the given length through the token slots.
+    */
+    buildTokenSlots();
+    uint32_t slot = hashName(name, length) & (TOKEN_NAME_SLOTS - 1);
+    while (tokenSlots[slot]) {
+        const char* candidate = tokenToString[tokenSlots[slot] - 1] + 3;
+        if (strlen(candidate) == length && memcmp(candidate, name, length) == 0)
+            return (Token)(tokenSlots[slot] - 1);
+        slot = (slot + 1) & (TOKEN_NAME_SLOTS - 1);
+    }
+    return TK_NOT_FOUND;
+}
+
+static int32_t* findNameSlot(int32_t* slots, uint32_t mask, const char* const* names,
+                             const uint32_t* lengths, const char* name, size_t length) {
+    /*
+       Probes a non-terminal name table for a name; returns its slot, or the
+       free slot where it belongs. lengths may be NULL for '\0' terminated names.
+    */
+    uint32_t slot = hashName(name, length) & mask;
+    while (slots[slot]) {
+        int nt = slots[slot] - 1;
+        size_t candidateLength = lengths ? lengths[nt] : strlen(names[nt]);
+        if (candidateLength == length && memcmp(names[nt], name, length) == 0)
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return &slots[slot];
+}
+
+static int internNonTerminal(GrammarBuilder* b, const char* name, uint32_t length) {
+    /*
+       Returns the index of a non-terminal, numbering new names in order of
+       first appearance. The name table is kept at most half full.
+    */
+    int32_t* slot = findNameSlot(b->nameSlots, b->nameMask, b->ntName, b->ntLength, name, length);
+    if (*slot)
+        return *slot - 1;
+
+    if (b->nonTerminals == MAX_LOADED_NONTERMINALS) {
+        fprintf(stderr, "%s:%d: more than %d non-terminals\n", b->name, b->line, MAX_LOADED_NONTERMINALS);
+        return -1;
+    }
+    if (!growArray((void**)&b->ntName, &b->ntCapacity, b->nonTerminals + 1, sizeof(const char*)))
+        return -1;
+    b->ntLength = (uint32_t*) realloc(b->ntLength, (size_t) b->ntCapacity * sizeof(uint32_t));
+    if (!b->ntLength) {
+        fprintf(stderr, "Memory allocation failed while reading a grammar\n");
+        return -1;
+    }
+    int nt = b->nonTerminals++;
+    b->ntName[nt] = name;
+    b->ntLength[nt] = length;
+    *slot = nt + 1;
+
+    // Rehash into twice the slots once half full
+    if ((uint32_t) b->nonTerminals * 2 > b->nameMask) {
+        uint32_t newMask = b->nameMask * 2 + 1;
+        int32_t* newSlots = (int32_t*) calloc((size_t) newMask + 1, sizeof(int32_t));
+        if (!newSlots) {
+            fprintf(stderr, "Memory allocation failed while reading a grammar\n");
+            return -1;
+        }
+        for (int i = 0; i < b->nonTerminals; i++)
+            *findNameSlot(newSlots, newMask, b->ntName, b->ntLength, b->ntName[i], b->ntLength[i]) = i + 1;
+        free(b->nameSlots);
+        b->nameSlots = newSlots;
+        b->nameMask = newMask;
+    }
+    return nt;
+}
+
+static bool addSymbol(GrammarBuilder* b, SymbolCode code) {
+    /*
+       Appends one right-hand side symbol.
+    */
+    int capacity = (int) b->symbolCapacity;
+    if (!growArray((void**)&b->symbols, &capacity, (int) b->symbolCount + 1, sizeof(SymbolCode)))
+        return false;
+    b->symbolCapacity = (uint32_t) capacity;
+    b->symbols[b->symbolCount++] = code;
+    return true;
+}
+
+static bool readRule(GrammarBuilder* b, const char* p, const char* end) {
+    /*
+       Reads the rule on one line: a bracketed left-hand side followed by
+       at least one symbol. Blank lines are skipped.
+    */
+    const char* words[2];
+    int lhs = -1;
+    int rhsLength = 0;
+
+    while (p < end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+            p++;
+        if (p == end)
+            break;
+        words[0] = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r')
+            p++;
+        words[1] = p;
+        uint32_t length = (uint32_t)(words[1] - words[0]);
+        bool bracketed = length > 2 && words[0][0] == '<' && words[0][length - 1] == '>';
+
+        if (lhs < 0) {
+            if (!bracketed) {
+                fprintf(stderr, "%s:%d: rule must start with a non-terminal, found %.*s\n",
+                        b->name, b->line, (int) length, words[0]);
+                return false;
+            }
+            if (b->ruleCount == MAX_LOADED_RULES) {
+                fprintf(stderr, "%s:%d: more than %d rules\n", b->name, b->line, MAX_LOADED_RULES);
+                return false;
+            }
+            if ((lhs = internNonTerminal(b, words[0], length)) < 0)
+                return false;
+            continue;
+        }
+
+        SymbolCode code;
+        if (bracketed) {
+            int nt = internNonTerminal(b, words[0], length);
+            if (nt < 0)
+                return false;
+            code = NT_CODE(nt);
+        } else {
+            Token tk = lookupGrammarToken(words[0], length);
+            if (tk == TK_NOT_FOUND) {
+                fprintf(stderr, "%s:%d: unknown terminal %.*s\n", b->name, b->line, (int) length, words[0]);
+                return false;
+            }
+            code = (SymbolCode) tk;
+        }
+        if (!addSymbol(b, code))
+            return false;
+        rhsLength++;
+    }
+
+    if (lhs < 0)
+        return true;
+    if (rhsLength == 0) {
+        fprintf(stderr, "%s:%d: rule has an empty right-hand side; write EPS\n", b->name, b->line);
+        return false;
+    }
+    if (!growArray((void**)&b->ruleLhs, &b->ruleCapacity, b->ruleCount + 1, sizeof(SymbolCode)))
+        return false;
+    b->ruleStart = (uint32_t*) realloc(b->ruleStart, ((size_t) b->ruleCapacity + 1) * sizeof(uint32_t));
+    if (!b->ruleStart) {
+        fprintf(stderr, "Memory allocation failed while reading a grammar\n");
+        return false;
+    }
+    b->ruleStart[b->ruleCount] = b->symbolCount - rhsLength;
+    b->ruleLhs[b->ruleCount] = NT_CODE(lhs);
+    b->ruleCount++;
+    return true;
+}
+
+static void freeBuilder(GrammarBuilder* b) {
+    /*
+       Releases the growable arrays of a builder.
+    */
+    free(b->ruleStart);
+    free(b->ruleLhs);
+    free(b->symbols);
+    free(b->ntName);
+    free(b->ntLength);
+    free(b->nameSlots);
+}
+
+static void fillTable(LoadedGrammar* g, RuleIndex* table) {
+    /*
+       Enters every rule in the cells of the tokens it predicts: FIRST of its
+       right-hand side, plus FOLLOW of its left-hand side when that is nullable.
+       A later rule claiming a cell replaces the earlier one, as in
+       addRulesToParseTable(), and counts as a conflict.
+    */
+    for (int r = 0; r < g->ruleCount; r++) {
+        int lhs = CODE_TO_NT(g->ruleLhs[r]);
+        TokenSet predict = 0;
+        bool nullable = true;
+        for (uint32_t i = g->ruleStart[r]; i < g->ruleStart[r + 1] && nullable; i++) {
+            SymbolCode code = g->symbols[i];
+            if (!IS_NT_CODE(code)) {
+                if (code != EPS) {
+                    predict |= TOKEN_BIT(code);
+                    nullable = false;
+                }
+                break;
+            }
+            TokenSet first = g->first[CODE_TO_NT(code)];
+            predict |= first & ~TOKEN_BIT(EPS);
+            nullable = IN_TOKEN_SET(first, EPS);
+        }
+        if (nullable)
+            predict |= g->follow[lhs];
+
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            if (tk == EPS || !IN_TOKEN_SET(predict, tk))
+                continue;
+            RuleIndex* cell = &table[lhs * TK_NOT_FOUND + tk];
+            if (*cell != NO_RULE && *cell != r + 1)
+                g->conflicts++;
+            *cell = (RuleIndex)(r + 1);
+        }
+    }
+}
+
+static LoadedGrammar* finishGrammar(GrammarBuilder* b, uint64_t hash) {
+    /*
+       Copies the rules and names into a fresh arena, then computes the
+       FIRST/FOLLOW sets and the parse table there.
+    */
+    Arena arena = {0};
+    LoadedGrammar* g = (LoadedGrammar*) arenaCalloc(&arena, sizeof(LoadedGrammar));
+    int nts = b->nonTerminals;
+
+    uint32_t* ruleStart = (uint32_t*) arenaAlloc(&arena, ((size_t) b->ruleCount + 1) * sizeof(uint32_t));
+    SymbolCode* ruleLhs = (SymbolCode*) arenaAlloc(&arena, (size_t) b->ruleCount * sizeof(SymbolCode));
+    SymbolCode* symbols = (SymbolCode*) arenaAlloc(&arena, ((size_t) b->symbolCount + 1) * sizeof(SymbolCode));
+    memcpy(ruleStart, b->ruleStart, (size_t) b->ruleCount * sizeof(uint32_t));
+    ruleStart[b->ruleCount] = b->symbolCount;
+    memcpy(ruleLhs, b->ruleLhs, (size_t) b->ruleCount * sizeof(SymbolCode));
+    memcpy(symbols, b->symbols, (size_t) b->symbolCount * sizeof(SymbolCode));
+
+    // Names become '\0' terminated copies; slots keep the builder's layout
+    char** names = (char**) arenaAlloc(&arena, (size_t) nts * sizeof(char*));
+    for (int nt = 0; nt < nts; nt++) {
+        names[nt] = (char*) arenaAlloc(&arena, b->ntLength[nt] + 1);
+        memcpy(names[nt], b->ntName[nt], b->ntLength[nt]);
+        names[nt][b->ntLength[nt]] = '\0';
+    }
+    int32_t* nameSlots = (int32_t*) arenaAlloc(&arena, ((size_t) b->nameMask + 1) * sizeof(int32_t));
+    memcpy(nameSlots, b->nameSlots, ((size_t) b->nameMask + 1) * sizeof(int32_t));
+
+    g->hash = hash;
+    g->ruleCount = b->ruleCount;
+    g->nonTerminals = nts;
+    g->startSymbol = CODE_TO_NT(ruleLhs[0]);
+    g->ruleStart = ruleStart;
+    g->ruleLhs = ruleLhs;
+    g->symbols = symbols;
+    g->nonTerminalNames = (const char* const*) names;
+    g->nameMask = b->nameMask;
+    g->nameSlots = nameSlots;
+
+    TokenSet* first = (TokenSet*) arenaCalloc(&arena, (size_t) nts * sizeof(TokenSet));
+    TokenSet* follow = (TokenSet*) arenaCalloc(&arena, (size_t) nts * sizeof(TokenSet));
+    FlatGrammar flat = { g->ruleCount, nts, g->startSymbol, ruleStart, ruleLhs, symbols };
+    if (!solveFirstFollow(&flat, first, follow)) {
+        fprintf(stderr, "%s: could not compute FIRST and FOLLOW sets\n", b->name);
+        destroyArena(&arena);
+        return NULL;
+    }
+    g->first = first;
+    g->follow = follow;
+
+    RuleIndex* table = (RuleIndex*) arenaCalloc(&arena, (size_t) nts * TK_NOT_FOUND * sizeof(RuleIndex));
+    fillTable(g, table);
+    g->table = table;
+
+    // The arena is complete; the object keeps it so it can release itself
+    g->arena = arena;
+    return g;
+}
+
+// ------------------------- LOADING -------------------------
+
+const LoadedGrammar* loadGrammarBuffer(const char* text, size_t length, const char* name) {
+    /*
+       Returns the cached grammar with the same text, or reads the text line
+       by line, analyzes it and adds it to the cache.
+    */
+    if (!text)
+        return NULL;
+    if (!name)
+        name = "<buffer>";
+
+    uint64_t hash = hashText(text, length);
+    const LoadedGrammar* cached = findLoadedGrammar(hash);
+    if (cached)
+        return cached;
+
+    GrammarBuilder b;
+    memset(&b, 0, sizeof(b));
+    b.name = name;
+    b.nameMask = MIN_NAME_SLOTS - 1;
+    b.nameSlots = (int32_t*) calloc(MIN_NAME_SLOTS, sizeof(int32_t));
+    bool ok = b.nameSlots != NULL;
+
+    const char* p = text;
+    const char* end = text + length;
+    while (ok && p < end) {
+        const char* lineEnd = (const char*) memchr(p, '\n', (size_t)(end - p));
+        if (!lineEnd)
+            lineEnd = end;
+        b.line++;
+        ok = readRule(&b, p, lineEnd);
+        p = lineEnd + 1;
+    }
+    if (ok && b.ruleCount == 0) {
+        fprintf(stderr, "%s: grammar has no rules\n", name);
+        ok = false;
+    }
+
+    LoadedGrammar* g = ok ? finishGrammar(&b, hash) : NULL;
+    freeBuilder(&b);
+    if (!g)
+        return NULL;
+    g->next = loadedGrammars;
+    loadedGrammars = g;
+    return g;
+}
+
+const LoadedGrammar* loadGrammarFile(const char* path) {
+    /*
+       Reads the whole file and loads it as a buffer.
+    */
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "Could not open grammar file %s\n", path);
+        return NULL;
+    }
+
+    char* text = NULL;
+    size_t length = 0;
+    long size = -1;
+    if (fseek(fp, 0, SEEK_END) == 0 && (size = ftell(fp)) >= 0 && fseek(fp, 0, SEEK_SET) == 0) {
+        text = (char*) malloc((size_t) size + 1);
+        if (text)
+            length = fread(text, 1, (size_t) size, fp);
+    }
+    fclose(fp);
+    if (!text || length != (size_t) size) {
+        fprintf(stderr, "Could not read grammar file %s\n", path);
+        free(text);
+        return NULL;
+    }
+
+    const LoadedGrammar* g = loadGrammarBuffer(text, length, path);
+    free(text);
+    return g;
+}
+
+const LoadedGrammar* findLoadedGrammar(uint64_t hash) {
+    /*
+       Walks the cache for a grammar with the given text hash.
+    */
+    for (LoadedGrammar* g = loadedGrammars; g; g = g->next) {
+        if (g->hash == hash)
+            return g;
+    }
+    return NULL;
+}
+
+int findGrammarNonTerminal(const LoadedGrammar* grammar, const char* name) {
+    /*
+       Probes the grammar's name table.
+    */
+    int32_t slot = *findNameSlot((int32_t*) grammar->nameSlots, grammar->nameMask,
+                                 (const char**) grammar->nonTerminalNames, NULL, name, strlen(name));
+    return slot - 1;
+}
+
+Token findGrammarToken(const char* name) {
+    /*
+       Resolves a terminal name as it is written in grammar files.
+    */
+    return lookupGrammarToken(name, strlen(name));
+}
+
+void unloadGrammars() {
+    /*
+       Destroys the arena of every cached grammar; each object lives in its
+       own arena, so it is copied out before the blocks are released.
+    */
+    LoadedGrammar* g = loadedGrammars;
+    while (g) {
+        LoadedGrammar* next = g->next;
+        Arena arena = g->arena;
+        destroyArena(&arena);
+        g = next;
+    }
+    loadedGrammars = NULL;
+}
@@ -0,0 +1,76 @@
+/*
+   ====================================================================
+   Grammar Loader - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   Reads grammars in the grammar.txt format from a file or from a
+   buffer in memory and turns each into an immutable LoadedGrammar:
+
+     <lhs> SYMBOL_1 SYMBOL_2 ... SYMBOL_n      (one rule per line)
+
+   Non-terminals are written in angle brackets and numbered in order
+   of first appearance, so a grammar may use any names and any number
+   of them; terminals are token names without their TK_ prefix. Names
+   are resolved through hash tables rather than string scans.
+
+   Loaded grammars are kept in a process-wide cache keyed by the hash
+   of their text, so several grammars can be used side by side and
+   loading the same text again returns the same object. The cache is
+   not synchronized: load grammars before starting worker threads.
+   ====================================================================
+*/
+
+#ifndef GRAMMAR_LOADER_H
+#define GRAMMAR_LOADER_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "arena.h"
+#include "parserDef.h"
+
+/* Constant Definitions */
+#define MAX_LOADED_RULES         (UINT16_MAX - 1)              // Rule indices + 1 must fit a RuleIndex
+#define MAX_LOADED_NONTERMINALS  (UINT16_MAX - TK_NOT_FOUND)   // Non-terminal codes must fit a SymbolCode
+
+// LoadedGrammar: A grammar with its FIRST/FOLLOW sets and LL(1) table.
+// Rules use the flat layout of FlatGrammar; non-terminal i has code NT_CODE(i).
+typedef struct LoadedGrammar {
+    uint64_t hash;                        // FNV-1a of the grammar text, as hashGrammarFile()
+    int ruleCount;                        // Number of rules
+    int nonTerminals;                     // Number of distinct non-terminals
+    int startSymbol;                      // Left-hand side of the first rule
+    const uint32_t* ruleStart;            // ruleCount + 1 offsets into symbols
+    const SymbolCode* ruleLhs;            // Left-hand side of every rule
+    const SymbolCode* symbols;            // Right-hand sides, end to end
+    const char* const* nonTerminalNames;  // Name of every non-terminal, brackets included
+    const TokenSet* first;                // FIRST of every non-terminal, EPS when nullable
+    const TokenSet* follow;               // FOLLOW of every non-terminal
+    const RuleIndex* table;               // nonTerminals x TK_NOT_FOUND cells: rule + 1, or NO_RULE
+    int conflicts;                        // Cells more than one rule predicts; 0 for an LL(1) grammar
+    uint32_t nameMask;                    // Slots of the name table minus one
+    const int32_t* nameSlots;             // Non-terminal index + 1 by name hash, 0 when free
+    Arena arena;                          // Owns everything above and the object itself
+    struct LoadedGrammar* next;           // Next grammar in the cache
+} LoadedGrammar;
+
+/* ----------- Loader Functions ----------- */
+// Load and analyze the grammar in a file. Returns the cached object when a
+// grammar with the same text is already loaded, or NULL on an error.
+const LoadedGrammar* loadGrammarFile(const char* path);
+
+// Load and analyze a grammar held in memory; name is used in error messages.
+const LoadedGrammar* loadGrammarBuffer(const char* text, size_t length, const char* name);
+
+// Find a loaded grammar by the hash of its text, or NULL.
+const LoadedGrammar* findLoadedGrammar(uint64_t hash);
+
+// Index of a non-terminal of the grammar by name (e.g. "<program>"), or -1.
+int findGrammarNonTerminal(const LoadedGrammar* grammar, const char* name);
+
+// Token of a terminal name as written in grammars (e.g. "ID"), or TK_NOT_FOUND.
+Token findGrammarToken(const char* name);
+
+// Release every loaded grammar. Objects returned earlier become invalid.
+void unloadGrammars();
+
+#endif
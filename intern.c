@@ -0,0 +1,157 @@
+/*
+   ====================================================================
+   Concurrent Intern Table Implementation
+   --------------------------------------------------------------------
+   Linear probing over an array of atomic entry pointers. Inserting
+   threads copy the entry into table-owned memory, stamp it with the
+   slot index and try to CAS it into the first empty slot on the probe
+   path. A thread that loses the race re-checks the winner: an equal
+   lexeme means the copy is dropped, any other lexeme means probing
+   continues with the next slot.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "intern.h"
+
+// ------------------------- HELPERS -------------------------
+
+static uint32_t hashLexeme(const char* lexeme, size_t length) {
+    /*
+       FNV-1a over the bytes of the lexeme.
+    */
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char) lexeme[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static bool sameLexeme(SymbolTableEntry* entry, const char* lexeme, size_t length) {
+    /*
+       Compares lengths first, then bytes.
+    */
+    return entry->length == length && memcmp(entry->lexeme, lexeme, length) == 0;
+}
+
+// ------------------------- TABLE LIFETIME -------------------------
+
+InternTable* createInternTable(uint32_t capacity) {
+    /*
+       Rounds the capacity up to a power of two and doubles it again, so
+       that the table stays at most half full when the estimate is right.
+    */
+    uint32_t slots = MIN_INTERN_CAPACITY;
+    while (slots < capacity * 2 && slots < (1u << 31))
+        slots <<= 1;
+
+    InternTable* table = (InternTable*) malloc(sizeof(InternTable));
+    if (!table) {
+        fprintf(stderr, "Memory allocation failed for InternTable\n");
+        return NULL;
+    }
+    table->slots = (_Atomic(SymbolTableEntry*)*) calloc(slots, sizeof(*table->slots));
+    if (!table->slots) {
+        fprintf(stderr, "Memory allocation failed for InternTable slots\n");
+        free(table);
+        return NULL;
+    }
+    for (uint32_t i = 0; i < slots; i++)
+        atomic_init(&table->slots[i], NULL);
+    table->capacity = slots;
+    table->mask = slots - 1;
+    atomic_init(&table->count, 0);
+    return table;
+}
+
+void destroyInternTable(InternTable* table) {
+    /*
+       Frees every published entry, then the slot array.
+    */
+    if (!table) return;
+    for (uint32_t i = 0; i < table->capacity; i++)
+        free(atomic_load_explicit(&table->slots[i], memory_order_relaxed));
+    free(table->slots);
+    free(table);
+}
+
+// ------------------------- LOOKUP / INSERT -------------------------
+
+SymbolTableEntry* internLookup(InternTable* table, const char* lexeme, size_t length) {
+    /*
+       Probes from the lexeme's home slot until the lexeme or an empty slot
+       is found. Acquire loads make the published entry's fields visible.
+    */
+    uint32_t slot = hashLexeme(lexeme, length) & table->mask;
+    for (uint32_t probes = 0; probes < table->capacity; probes++) {
+        SymbolTableEntry* entry = atomic_load_explicit(&table->slots[slot], memory_order_acquire);
+        if (!entry)
+            return NULL;
+        if (sameLexeme(entry, lexeme, length))
+            return entry;
+        slot = (slot + 1) & table->mask;
+    }
+    return NULL;
+}
+
+SymbolTableEntry* internEntry(InternTable* table, SymbolTableEntry* entry) {
+    /*
+       Publishes a table-owned copy of the entry. The copy is only made
+       once an empty slot is seen, and its id is rewritten before every
+       CAS attempt since nobody else can see it until the CAS succeeds.
+    */
+    size_t length = entry->length;
+    size_t bytes = sizeof(SymbolTableEntry) + length + 1;
+    SymbolTableEntry* copy = NULL;
+
+    uint32_t slot = hashLexeme(entry->lexeme, length) & table->mask;
+    for (uint32_t probes = 0; probes < table->capacity; probes++) {
+        SymbolTableEntry* current = atomic_load_explicit(&table->slots[slot], memory_order_acquire);
+        if (!current) {
+            if (!copy) {
+                copy = (SymbolTableEntry*) malloc(bytes);
+                if (!copy) {
+                    fprintf(stderr, "Memory allocation failed for an interned entry\n");
+                    return NULL;
+                }
+                memcpy(copy, entry, bytes);
+            }
+            copy->id = slot;
+            if (atomic_compare_exchange_strong_explicit(&table->slots[slot], &current, copy,
+                                                        memory_order_acq_rel, memory_order_acquire)) {
+                atomic_fetch_add_explicit(&table->count, 1, memory_order_relaxed);
+                return copy;
+            }
+            // Another thread filled the slot first; current now holds its entry
+        }
+        if (sameLexeme(current, entry->lexeme, length)) {
+            free(copy);
+            return current;
+        }
+        slot = (slot + 1) & table->mask;
+    }
+
+    free(copy);
+    fprintf(stderr, "InternTable is full (%u slots)\n", table->capacity);
+    return NULL;
+}
+
+SymbolTableEntry* internEntryAt(InternTable* table, uint32_t id) {
+    /*
+       Reads a slot with an acquire load, pairing with the CAS that
+       published the entry, so its fields are visible to the caller.
+    */
+    if (id >= table->capacity)
+        return NULL;
+    return atomic_load_explicit(&table->slots[id], memory_order_acquire);
+}
+
+uint32_t internCount(InternTable* table) {
+    /*
+       Returns the number of published entries.
+    */
+    return atomic_load_explicit(&table->count, memory_order_relaxed);
+}
@@ -0,0 +1,59 @@
+/*
+   ====================================================================
+   Concurrent Intern Table - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   A fixed-capacity, lock-free open-addressing hash table of symbol
+   table entries, shared by lexers running on several threads. Every
+   distinct lexeme is published exactly once into a slot with a
+   compare-and-swap, and the slot index is its global symbol id, so
+   later phases can compare symbols from different files by id.
+
+   Slots are never removed or moved, which keeps lookups wait-free:
+   a reader probes until it finds the lexeme or an empty slot.
+   The table never grows, so size it for every lexeme of the run; a
+   lexer that meets a new lexeme once it is full stops with an error.
+   ====================================================================
+*/
+
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "lexerDef.h"
+
+/* Constant Definitions */
+#define MIN_INTERN_CAPACITY   64     // Smallest table created
+
+// InternTable: Shared dictionary of lexemes; the id of an entry is its slot.
+typedef struct InternTable {
+    uint32_t capacity;                       // Number of slots (a power of two)
+    uint32_t mask;                           // capacity - 1
+    _Atomic(SymbolTableEntry*)* slots;       // Published entries, NULL while free
+    atomic_uint count;                       // Number of published entries
+} InternTable;
+
+/* ----------- Intern Table Functions ----------- */
+// Create a table able to hold at least the given number of distinct lexemes.
+InternTable* createInternTable(uint32_t capacity);
+
+// Find the entry of a lexeme, or NULL when it has not been interned.
+SymbolTableEntry* internLookup(InternTable* table, const char* lexeme, size_t length);
+
+// Publish a copy of the entry unless its lexeme is already present, and
+// return the entry that is in the table. Returns NULL when the table is full.
+SymbolTableEntry* internEntry(InternTable* table, SymbolTableEntry* entry);
+
+// Entry published in the given slot, or NULL for a free slot or an id out of range.
+SymbolTableEntry* internEntryAt(InternTable* table, uint32_t id);
+
+// Number of distinct lexemes interned so far.
+uint32_t internCount(InternTable* table);
+
+// Release the table and every entry published into it.
+// No thread may be using the table any more.
+void destroyInternTable(InternTable* table);
+
+#endif
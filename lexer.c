@@ -11,15 +11,28 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <pthread.h>
+#include <sys/mman.h>
 #include "lexer.h"
 #include "lexerDef.h"
+#include "arena.h"
+#include "intern.h"
+#include "newline.h"
 
 /* Global variables for token-string mapping and flags */
-bool retractFlag = false;  
+_Thread_local bool retractFlag = false;  
 char* tokenToString[TK_NOT_FOUND];         
-bool tkStrInitialized = false;     
 bool debugPrint = false;
 
+/* Slab pool recycling the DFA's per-token result nodes */
+_Thread_local SlabPool tokenNodePool = SLAB_POOL(TokenNode, NULL);
+
+// Source offset of the first character held by each half of the twin buffer
+_Thread_local int64_t bufferOffset[2] = { 0, -BUFFER_SZ };
+
+// Source file the tokens being scanned belong to
+_Thread_local SourceFileId currentSourceFile = 0;
+
 // ========================= SECTION 1: DATA STRUCTURE IMPLEMENTATIONS =========================
 
 // ------------------------- TRIE IMPLEMENTATION (FOR KEYWORDS) -------------------------
@@ -27,15 +40,9 @@ bool debugPrint = false;
 TrieNode* newTrieNode() {
     /*
        Creates and initializes a new trie node with all children set to NULL.
-       Uses calloc for zero initialization of the node memory.
+       Nodes live in the compilation arena, zeroed on allocation.
     */
-    // Use calloc for automatic zero initialization
-    TrieNode* node = (TrieNode*) calloc(1, sizeof(TrieNode));
-    if (!node) {
-        fprintf(stderr, "Memory allocation failed for TrieNode\n");
-        exit(EXIT_FAILURE);
-    }
-    // No need to manually initialize since calloc already sets everything to 0
+    TrieNode* node = (TrieNode*) arenaCalloc(&compilationArena, sizeof(TrieNode));
     return node;
 }
 
@@ -44,11 +51,7 @@ Trie* initTrie() {
        Initializes a trie data structure with a root node.
        The trie is used to store keywords for efficient lookup.
     */
-    Trie* trie = (Trie*) malloc(sizeof(Trie));
-    if (!trie) {
-        fprintf(stderr, "Memory allocation failed for Trie\n");
-        exit(EXIT_FAILURE);
-    }
+    Trie* trie = (Trie*) arenaAlloc(&compilationArena, sizeof(Trie));
     
     // Create the root node
     trie->root = newTrieNode();
@@ -129,65 +132,90 @@ SymbolTable* newSymbolTable() {
        Creates and initializes a new symbol table with initial capacity.
        The symbol table stores all tokens found during lexical analysis.
     */
-    // Allocate the symbol table structure
-    SymbolTable* table = (SymbolTable*) malloc(sizeof(SymbolTable));
-    if (!table) {
-        fprintf(stderr, "Memory allocation failed for Symbol Table\n");
-        return NULL;
-    }
-    
-    // Allocate the entries array
-    table->entries = (SymbolTableEntry**) calloc(INIT_SYMBOL_TABLE_CAP, sizeof(SymbolTableEntry*));
-    if (!table->entries) {
-        fprintf(stderr, "Memory allocation failed for Symbol Table entries\n");
-        free(table);  // Clean up the previously allocated memory
-        return NULL;
-    }
+    // Allocate the symbol table structure and its entries array
+    SymbolTable* table = (SymbolTable*) arenaAlloc(&compilationArena, sizeof(SymbolTable));
+    table->entries = (SymbolTableEntry**) arenaCalloc(&compilationArena, INIT_SYMBOL_TABLE_CAP * sizeof(SymbolTableEntry*));
     
     // Initialize the fields
     table->capacity = INIT_SYMBOL_TABLE_CAP;
     table->size = 0;
+    table->shared = NULL;
+    
+    return table;
+}
+
+SymbolTable* newSharedSymbolTable(InternTable* shared) {
+    /*
+       Creates a symbol table backed by a shared intern table. Lookups and
+       insertions go to the intern table; ids are slot indexes, resolved
+       by getSymbolEntry() with an acquire load of the slot.
+    */
+    if (!shared) {
+        fprintf(stderr, "NULL intern table passed to newSharedSymbolTable\n");
+        return NULL;
+    }
+    SymbolTable* table = (SymbolTable*) arenaAlloc(&compilationArena, sizeof(SymbolTable));
+    
+    table->entries = NULL;
+    table->capacity = (int) shared->capacity;
+    table->size = (int) shared->capacity;
+    table->shared = shared;
     
     return table;
 }
 
-void addToken(SymbolTable* table, SymbolTableEntry* entry) {
+bool addToken(SymbolTable* table, SymbolTableEntry* entry) {
     /*
        Adds a token entry to the symbol table, growing the table if needed.
-       Handles dynamic resizing of the table when capacity is reached.
+       On growth the entries are copied to a larger array in the arena;
+       the old array is reclaimed with the rest of the compilation.
+       Returns false, leaving the entry without an id, when a shared
+       table is full.
     */
     // Validate parameters
     if (!table || !entry) {
         fprintf(stderr, "Invalid parameters to addToken\n");
-        return;
+        return false;
+    }
+    
+    // Shared tables publish a copy; the caller's entry takes the id of
+    // whichever copy ends up in the table. Numbers are converted first so
+    // that the published copy is never written again by getNumericValue()
+    if (table->shared) {
+        getNumericValue(entry);
+        SymbolTableEntry* interned = internEntry(table->shared, entry);
+        if (!interned)
+            return false;
+        entry->id = interned->id;
+        return true;
     }
     
     // Check if we need to grow the table
     if (table->size >= table->capacity) {
         size_t newCapacity = table->capacity * 2;
-        SymbolTableEntry** newEntries = (SymbolTableEntry**) realloc(
-            table->entries, 
+        SymbolTableEntry** newEntries = (SymbolTableEntry**) arenaAlloc(
+            &compilationArena, 
             newCapacity * sizeof(SymbolTableEntry*)
         );
-        
-        if (!newEntries) {
-            fprintf(stderr, "Failed to resize Symbol Table (current size: %d)\n", table->size);
-            return;
-        }
+        memcpy(newEntries, table->entries, table->size * sizeof(SymbolTableEntry*));
         
         table->entries = newEntries;
         table->capacity = newCapacity;
     }
     
-    // Add the new entry and increment the size
+    // Add the new entry, record its position and increment the size
+    entry->id = (uint32_t) table->size;
     table->entries[table->size] = entry;
     table->size++;
+    return true;
 }
 
-SymbolTableEntry* newSymbolTableEntry(char* lexeme, Token tkType, double numVal) {
+SymbolTableEntry* newSymbolTableEntry(char* lexeme, Token tkType) {
     /*
        Creates a new symbol table entry with the provided token information.
-       Includes storage for the lexeme string, token type, and numeric value.
+       The lexeme is stored inline and the entry is sized to fit it exactly,
+       so entries are packed densely into the compilation arena.
+       Numeric values are not computed here; see getNumericValue().
     */
     // Validate parameter
     if (!lexeme) {
@@ -195,23 +223,78 @@ SymbolTableEntry* newSymbolTableEntry(char* lexeme, Token tkType, double numVal)
         return NULL;
     }
     
-    // Allocate the entry
-    SymbolTableEntry* entry = (SymbolTableEntry*) malloc(sizeof(SymbolTableEntry));
-    if (!entry) {
-        fprintf(stderr, "Memory allocation failed for Symbol Table Entry\n");
-        return NULL;
-    }
+    size_t len = strlen(lexeme);
+    if (len > BUFFER_SZ - 1)
+        len = BUFFER_SZ - 1;
     
-    // Initialize the fields with safe string copy
-    strncpy(entry->lexeme, lexeme, BUFFER_SZ - 1);
-    entry->lexeme[BUFFER_SZ - 1] = '\0';  // Ensure null termination
+    // Allocate the entry along with room for the lexeme
+    SymbolTableEntry* entry = (SymbolTableEntry*) arenaAlloc(&compilationArena, sizeof(SymbolTableEntry) + len + 1);
+    
+    // Initialize the fields with the length-prefixed lexeme
+    memcpy(entry->lexeme, lexeme, len);
+    entry->lexeme[len] = '\0';
+    entry->length = (unsigned short) len;
     
     entry->tokenType = tkType;
-    entry->numericValue = numVal;
+    entry->numericValue = 0;
+    entry->valueReady = false;
+    entry->id = NO_SYMBOL_ID;
     
     return entry;
 }
 
+double getNumericValue(SymbolTableEntry* entry) {
+    /*
+       Returns the value of a NUM or RNUM entry, converting its lexeme the
+       first time it is asked for and memoizing the result in the entry.
+       Entries in a shared table are converted before they are published,
+       so threads reading them only ever take the memoized value.
+       Lexemes follow the DFA: digits, optionally ".dd", optionally "E[+|-]dd".
+       Entries of any other token have the value 0.
+    */
+    if (!entry)
+        return 0;
+    if (entry->valueReady)
+        return entry->numericValue;
+    
+    double val = 0;
+    if (entry->tokenType == NUM || entry->tokenType == RNUM) {
+        const char* p = entry->lexeme;
+        for (; isdigit(*p); p++) {
+            val = val * 10 + (*p - '0');
+        }
+        if (*p == '.' && isdigit(p[1]) && isdigit(p[2])) {
+            val += (p[1] - '0') / 10.0 + (p[2] - '0') / 100.0;
+            p += 3;
+            if (*p == 'E') {
+                p++;
+                bool negative = (*p == '-');
+                if (*p == '+' || *p == '-')
+                    p++;
+                int exp = (p[0] - '0') * 10 + (p[1] - '0');
+                val *= pow(10, negative ? -exp : exp);
+            }
+        }
+    }
+    
+    entry->numericValue = val;
+    entry->valueReady = true;
+    return val;
+}
+
+SymbolTableEntry* getSymbolEntry(SymbolTable* table, uint32_t id) {
+    /*
+       Returns the entry with the given symbol id, or NULL for an id outside
+       the table. Shared tables are read through the intern table's atomic
+       slots, so entries published by other threads are seen complete.
+    */
+    if (!table || id >= (uint32_t) table->size)
+        return NULL;
+    if (table->shared)
+        return internEntryAt(table->shared, id);
+    return table->entries[id];
+}
+
 SymbolTableEntry* lookupToken(SymbolTable* table, char* lexeme) {
     /*
        Searches for a lexeme in the symbol table.
@@ -222,10 +305,15 @@ SymbolTableEntry* lookupToken(SymbolTable* table, char* lexeme) {
         return NULL;
     }
     
-    // Sequential search through the entries
+    size_t len = strlen(lexeme);
+    if (table->shared)
+        return internLookup(table->shared, lexeme, len);
+    
+    // Sequential search through the entries, comparing lengths first
     for (int i = 0; i < table->size; i++) {
-        if (table->entries[i] && strcmp(lexeme, table->entries[i]->lexeme) == 0) {
-            return table->entries[i];
+        SymbolTableEntry* entry = table->entries[i];
+        if (entry && entry->length == len && memcmp(lexeme, entry->lexeme, len) == 0) {
+            return entry;
         }
     }
     
@@ -233,32 +321,12 @@ SymbolTableEntry* lookupToken(SymbolTable* table, char* lexeme) {
     return NULL;
 }
 
-// ------------------------- TOKEN LIST IMPLEMENTATION -------------------------
-
-TokenList* createTokenList() {
-    /*
-       Creates and initializes a new empty token list structure.
-       The token list stores tokens in the order they appear in the input.
-    */
-    // Allocate memory for the list structure
-    TokenList* list = (TokenList*) malloc(sizeof(TokenList));
-    if (!list) {
-        fprintf(stderr, "Memory allocation failed for TokenList\n");
-        return NULL;
-    }
-    
-    // Initialize all fields
-    list->count = 0;
-    list->head = NULL;
-    list->tail = NULL;
-    
-    return list;
-}
+// ------------------------- TOKEN BUFFER IMPLEMENTATION -------------------------
 
 TokenNode* newTokenNode(SymbolTableEntry* entry, int lineNum) {
     /*
        Creates a new token node containing the given entry and line number.
-       Each node represents one token in the input.
+       Each node represents one token as recognized by the DFA.
     */
     // Validate parameter
     if (!entry) {
@@ -266,48 +334,119 @@ TokenNode* newTokenNode(SymbolTableEntry* entry, int lineNum) {
         return NULL;
     }
     
-    // Allocate memory for the node
-    TokenNode* node = (TokenNode*) malloc(sizeof(TokenNode));
-    if (!node) {
-        fprintf(stderr, "Memory allocation failed for TokenNode\n");
-        return NULL;
-    }
+    // Take a node from the pool; it goes back once copied into the token buffer
+    TokenNode* node = (TokenNode*) poolAlloc(&tokenNodePool);
     
     // Initialize node fields
     node->entry = entry;
     node->lineNum = lineNum;
-    node->next = NULL;
+    node->loc = NO_SOURCE_LOC;
     
     return node;
 }
 
-void appendTokenNode(TokenList* list, TokenNode* node) {
+TokenBuffer* createTokenBuffer(SymbolTable* symbols, bool withSpans) {
     /*
-       Adds a token node to the end of the token list.
-       Maintains both head and tail pointers for efficient operations.
+       Creates an empty token buffer whose symbol ids refer to the given table.
+       The span array is only allocated when spans are requested.
     */
-    // Validate parameters
-    if (!list || !node) {
-        fprintf(stderr, "NULL parameter passed to appendTokenNode\n");
-        return;
+    TokenBuffer* buf = (TokenBuffer*) calloc(1, sizeof(TokenBuffer));
+    if (!buf) {
+        fprintf(stderr, "Memory allocation failed for TokenBuffer\n");
+        return NULL;
     }
     
-    // Handle the first node case
-    if (list->count == 0) {
-        list->head = node;
-        list->tail = node;
+    buf->capacity = INIT_TOKEN_BUFFER_CAP;
+    buf->symbols = symbols;
+    buf->kind = (uint8_t*) malloc(buf->capacity * sizeof(uint8_t));
+    buf->symbolId = (uint32_t*) malloc(buf->capacity * sizeof(uint32_t));
+    buf->lineNum = (uint32_t*) malloc(buf->capacity * sizeof(uint32_t));
+    if (withSpans)
+        buf->span = (SourceLoc*) malloc(buf->capacity * sizeof(SourceLoc));
+    
+    if (!buf->kind || !buf->symbolId || !buf->lineNum || (withSpans && !buf->span)) {
+        fprintf(stderr, "Memory allocation failed for TokenBuffer arrays\n");
+        freeTokenBuffer(buf);
+        return NULL;
     }
-    // Normal append operation
-    else {
-        list->tail->next = node;
-        list->tail = node;
+    
+    return buf;
+}
+
+bool appendToken(TokenBuffer* buf, SymbolTableEntry* entry, int lineNum, SourceLoc span) {
+    /*
+       Appends one token to the end of the buffer, doubling every array when full.
+       Entries that are not in the buffer's symbol table yet (such as the
+       end-of-file marker) are added to it so that they receive an id.
+       Returns false if the arrays could not grow or the entry has no id.
+    */
+    // Validate parameters
+    if (!buf || !entry) {
+        fprintf(stderr, "NULL parameter passed to appendToken\n");
+        return false;
+    }
+    
+    // Grow all parallel arrays together
+    if (buf->count == buf->capacity) {
+        int newCapacity = buf->capacity * 2;
+        uint8_t* newKind = (uint8_t*) realloc(buf->kind, newCapacity * sizeof(uint8_t));
+        if (newKind) buf->kind = newKind;
+        uint32_t* newIds = (uint32_t*) realloc(buf->symbolId, newCapacity * sizeof(uint32_t));
+        if (newIds) buf->symbolId = newIds;
+        uint32_t* newLines = (uint32_t*) realloc(buf->lineNum, newCapacity * sizeof(uint32_t));
+        if (newLines) buf->lineNum = newLines;
+        SourceLoc* newSpans = buf->span;
+        if (buf->span) {
+            newSpans = (SourceLoc*) realloc(buf->span, newCapacity * sizeof(SourceLoc));
+            if (newSpans) buf->span = newSpans;
+        }
+        
+        if (!newKind || !newIds || !newLines || !newSpans) {
+            fprintf(stderr, "Failed to resize TokenBuffer (current size: %d)\n", buf->count);
+            return false;
+        }
+        buf->capacity = newCapacity;
     }
     
-    // Ensure the node is properly terminated
-    node->next = NULL;
+    if (entry->id == NO_SYMBOL_ID && !addToken(buf->symbols, entry))
+        return false;
     
-    // Update count
-    list->count++;
+    buf->kind[buf->count] = (uint8_t) entry->tokenType;
+    buf->symbolId[buf->count] = entry->id;
+    buf->lineNum[buf->count] = (uint32_t) lineNum;
+    if (buf->span)
+        buf->span[buf->count] = span;
+    buf->count++;
+    return true;
+}
+
+SymbolTableEntry* getTokenEntry(TokenBuffer* buf, int index) {
+    /*
+       Returns the symbol table entry of the token at the given index,
+       or NULL if the index or the token's symbol id is out of range.
+    */
+    if (!buf || index < 0 || index >= buf->count)
+        return NULL;
+    return getSymbolEntry(buf->symbols, buf->symbolId[index]);
+}
+
+void freeTokenBuffer(TokenBuffer* buf) {
+    /*
+       Releases the token arrays, or unmaps them for a buffer read from a
+       token stream. The symbol table is left alone since parse trees keep
+       pointing at its entries.
+    */
+    if (!buf) return;
+    if (buf->mappedBase) {
+        munmap(buf->mappedBase, buf->mappedSize);
+        free(buf);
+        return;
+    }
+    free(buf->kind);
+    free(buf->symbolId);
+    free(buf->lineNum);
+    free(buf->span);
+    free(buf);
 }
 
 // ========================= SECTION 2: BUFFER HANDLING =========================
@@ -332,6 +471,7 @@ char fetchNextChar(FILE* fp, char *buffer, int *forwardPtr) {
             buffer[BUFFER_SZ] = '\0';
         } else {
             // Load the next chunk into the second segment
+            bufferOffset[1] = bufferOffset[0] + BUFFER_SZ;
             int bytesRead = fread(buffer + BUFFER_SZ, sizeof(char), BUFFER_SZ, fp);
             
             // Set null terminator if we read less than the full buffer size
@@ -347,6 +487,7 @@ char fetchNextChar(FILE* fp, char *buffer, int *forwardPtr) {
             buffer[0] = '\0';
         } else {
             // Load the next chunk into the first segment
+            bufferOffset[0] = bufferOffset[1] + BUFFER_SZ;
             int bytesRead = fread(buffer, sizeof(char), BUFFER_SZ, fp);
             
             // Set null terminator if we read less than the full buffer size
@@ -368,6 +509,42 @@ char fetchNextChar(FILE* fp, char *buffer, int *forwardPtr) {
     return buffer[*forwardPtr];
 }
 
+char skipToLineEnd(FILE* fp, char *buffer, int *forwardPtr) {
+    /*
+       Advances the forward pointer to the next '\n' and returns it. Within
+       a loaded half the search is a bulk scan; crossing into the other half
+       goes through fetchNextChar() so that it is reloaded as usual.
+       At the end of input the pointer is left just before the '\0' marker,
+       so that the next token is the end-of-file token, and '\0' is returned.
+    */
+    while (true) {
+        int next = (*forwardPtr + 1) % (2 * BUFFER_SZ);
+        char ch;
+        if (retractFlag || next == 0 || next == BUFFER_SZ) {
+            ch = fetchNextChar(fp, buffer, forwardPtr);
+        } else {
+            int halfEnd = next < BUFFER_SZ ? BUFFER_SZ : 2 * BUFFER_SZ;
+            int found = (int) findLineEnd(buffer + next, (size_t)(halfEnd - next));
+            if (next + found == halfEnd) {
+                *forwardPtr = halfEnd - 1;
+                continue;
+            }
+            *forwardPtr = next + found;
+            ch = buffer[*forwardPtr];
+        }
+        
+        if (ch == '\n')
+            return ch;
+        if (ch == '\0') {
+            --(*forwardPtr);
+            if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
+            if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
+                retractFlag = true;
+            return ch;
+        }
+    }
+}
+
 void extractLexeme(int beginPtr, int* forwardPtr, char* lexeme, char* buffer) {
     /*
        Extracts characters between beginPtr and forwardPtr from the twin buffer into lexeme.
@@ -439,15 +616,26 @@ int getLexemeLength(int begPtr, int forwardPtr) {
 
 // ------------------------- DFA FOR TOKEN RECOGNITION -------------------------
 
-TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum, 
-                          Trie* keywordTrie, SymbolTable* symTable) {
+static SourceLoc tokenSpan(int beginPtr, SymbolTableEntry* entry) {
+    /*
+       Builds the span of a token starting at beginPtr in the twin buffer.
+       Must be called while the half holding beginPtr is still loaded.
+    */
+    int64_t offset = bufferOffset[beginPtr / BUFFER_SZ] + beginPtr % BUFFER_SZ;
+    uint32_t length = entry->tokenType == DOLLAR ? 0 : entry->length;
+    return makeSourceLoc(currentSourceFile, (uint32_t) offset, length);
+}
+
+static TokenNode* scanToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum, 
+                            Trie* keywordTrie, SymbolTable* symTable, int* beginPtr) {
     /*
        Implements the DFA for tokenizing the input.
        Reads characters from the twin buffer, transitions through states,
        and returns a TokenNode when a valid token is recognized.
+       beginPtr is left on the first character of the recognized token.
     */
     TokenNode* tokenNode;
-    int beginPtr = (*forwardPtr + 1) % (2 * BUFFER_SZ);
+    *beginPtr = (*forwardPtr + 1) % (2 * BUFFER_SZ);
     int state = 0;
     char ch;
     char lexeme[BUFFER_SZ];
@@ -460,9 +648,9 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 // Whitespace handling
                 if (ch == '\n') {
                     ++(*lineNum);
-                    beginPtr = (beginPtr + 1) % (2 * BUFFER_SZ);
+                    *beginPtr = (*beginPtr + 1) % (2 * BUFFER_SZ);
                 } else if (ch == ' ' || ch == '\t' || ch == '\r') {
-                    beginPtr = (beginPtr + 1) % (2 * BUFFER_SZ);
+                    *beginPtr = (*beginPtr + 1) % (2 * BUFFER_SZ);
                 } 
                 // Numbers
                 else if (isdigit(ch)) {
@@ -525,7 +713,7 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 // End of file
                 else if (ch == '\0') {
                     lexeme[0] = ch;
-                    SymbolTableEntry* eofEntry = newSymbolTableEntry(lexeme, DOLLAR, 0);
+                    SymbolTableEntry* eofEntry = newSymbolTableEntry(lexeme, DOLLAR);
                     tokenNode = newTokenNode(eofEntry, *lineNum);
                     return tokenNode;
                 } 
@@ -535,7 +723,7 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     lexeme[1] = '\0';
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -557,10 +745,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* ltEntry = lookupToken(symTable, lexeme);
                     if (!ltEntry) {
-                        ltEntry = newSymbolTableEntry(lexeme, LT, 0);
+                        ltEntry = newSymbolTableEntry(lexeme, LT);
                         addToken(symTable, ltEntry);
                     }
                     tokenNode = newTokenNode(ltEntry, *lineNum);
@@ -578,10 +766,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == BUFFER_SZ - 2 ||
                         *forwardPtr == 2 * BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 2)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* ltEntry = lookupToken(symTable, lexeme);
                     if (!ltEntry) {
-                        ltEntry = newSymbolTableEntry(lexeme, LT, 0);
+                        ltEntry = newSymbolTableEntry(lexeme, LT);
                         addToken(symTable, ltEntry);
                     }
                     tokenNode = newTokenNode(ltEntry, *lineNum);
@@ -598,10 +786,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -610,11 +798,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 4: // Assignment operator <--- complete
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* asgnEntry = lookupToken(symTable, lexeme);
                     if (!asgnEntry) {
-                        asgnEntry = newSymbolTableEntry(lexeme, ASSIGNOP, 0);
+                        asgnEntry = newSymbolTableEntry(lexeme, ASSIGNOP);
                         addToken(symTable, asgnEntry);
                     }
                     tokenNode = newTokenNode(asgnEntry, *lineNum);
@@ -623,11 +811,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 6: // Less than or equal <=
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* leEntry = lookupToken(symTable, lexeme);
                     if (!leEntry) {
-                        leEntry = newSymbolTableEntry(lexeme, LE, 0);
+                        leEntry = newSymbolTableEntry(lexeme, LE);
                         addToken(symTable, leEntry);
                     }
                     tokenNode = newTokenNode(leEntry, *lineNum);
@@ -636,11 +824,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
                 
             case 43: // Dot '.'
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* dotEntry = lookupToken(symTable, lexeme);
                     if (!dotEntry) {
-                        dotEntry = newSymbolTableEntry(lexeme, DOT, 0);
+                        dotEntry = newSymbolTableEntry(lexeme, DOT);
                         addToken(symTable, dotEntry);
                     }
                     tokenNode = newTokenNode(dotEntry, *lineNum);
@@ -657,10 +845,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -669,11 +857,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 49: // Equal operator ==
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* eqEntry = lookupToken(symTable, lexeme);
                     if (!eqEntry) {
-                        eqEntry = newSymbolTableEntry(lexeme, EQ, 0);
+                        eqEntry = newSymbolTableEntry(lexeme, EQ);
                         addToken(symTable, eqEntry);
                     }
                     tokenNode = newTokenNode(eqEntry, *lineNum);
@@ -690,10 +878,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* gtEntry = lookupToken(symTable, lexeme);
                     if (!gtEntry) {
-                        gtEntry = newSymbolTableEntry(lexeme, GT, 0);
+                        gtEntry = newSymbolTableEntry(lexeme, GT);
                         addToken(symTable, gtEntry);
                     }
                     tokenNode = newTokenNode(gtEntry, *lineNum);
@@ -702,11 +890,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 61: // Greater than or equal >=
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* geEntry = lookupToken(symTable, lexeme);
                     if (!geEntry) {
-                        geEntry = newSymbolTableEntry(lexeme, GE, 0);
+                        geEntry = newSymbolTableEntry(lexeme, GE);
                         addToken(symTable, geEntry);
                     }
                     tokenNode = newTokenNode(geEntry, *lineNum);
@@ -715,11 +903,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 57: // Not equal !=
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* neEntry = lookupToken(symTable, lexeme);
                     if (!neEntry) {
-                        neEntry = newSymbolTableEntry(lexeme, NE, 0);
+                        neEntry = newSymbolTableEntry(lexeme, NE);
                         addToken(symTable, neEntry);
                     }
                     tokenNode = newTokenNode(neEntry, *lineNum);
@@ -736,10 +924,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -749,11 +937,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 
             // Basic operators and symbols
             case 36: // Left square bracket [
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* sqlEntry = lookupToken(symTable, lexeme);
                     if (!sqlEntry) {
-                        sqlEntry = newSymbolTableEntry(lexeme, SQL, 0);
+                        sqlEntry = newSymbolTableEntry(lexeme, SQL);
                         addToken(symTable, sqlEntry);
                     }
                     tokenNode = newTokenNode(sqlEntry, *lineNum);
@@ -762,11 +950,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 37: // Right square bracket ]
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* sqrEntry = lookupToken(symTable, lexeme);
                     if (!sqrEntry) {
-                        sqrEntry = newSymbolTableEntry(lexeme, SQR, 0);
+                        sqrEntry = newSymbolTableEntry(lexeme, SQR);
                         addToken(symTable, sqrEntry);
                     }
                     tokenNode = newTokenNode(sqrEntry, *lineNum);
@@ -775,11 +963,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 38: // Comma ,
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* commaEntry = lookupToken(symTable, lexeme);
                     if (!commaEntry) {
-                        commaEntry = newSymbolTableEntry(lexeme, COMMA, 0);
+                        commaEntry = newSymbolTableEntry(lexeme, COMMA);
                         addToken(symTable, commaEntry);
                     }
                     tokenNode = newTokenNode(commaEntry, *lineNum);
@@ -788,11 +976,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 39: // Semicolon ;
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* semEntry = lookupToken(symTable, lexeme);
                     if (!semEntry) {
-                        semEntry = newSymbolTableEntry(lexeme, SEM, 0);
+                        semEntry = newSymbolTableEntry(lexeme, SEM);
                         addToken(symTable, semEntry);
                     }
                     tokenNode = newTokenNode(semEntry, *lineNum);
@@ -801,11 +989,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 40: // Colon :
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* colonEntry = lookupToken(symTable, lexeme);
                     if (!colonEntry) {
-                        colonEntry = newSymbolTableEntry(lexeme, COLON, 0);
+                        colonEntry = newSymbolTableEntry(lexeme, COLON);
                         addToken(symTable, colonEntry);
                     }
                     tokenNode = newTokenNode(colonEntry, *lineNum);
@@ -814,11 +1002,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 41: // Left parenthesis (
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* opEntry = lookupToken(symTable, lexeme);
                     if (!opEntry) {
-                        opEntry = newSymbolTableEntry(lexeme, OP, 0);
+                        opEntry = newSymbolTableEntry(lexeme, OP);
                         addToken(symTable, opEntry);
                     }
                     tokenNode = newTokenNode(opEntry, *lineNum);
@@ -827,11 +1015,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 42: // Right parenthesis )
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* clEntry = lookupToken(symTable, lexeme);
                     if (!clEntry) {
-                        clEntry = newSymbolTableEntry(lexeme, CL, 0);
+                        clEntry = newSymbolTableEntry(lexeme, CL);
                         addToken(symTable, clEntry);
                     }
                     tokenNode = newTokenNode(clEntry, *lineNum);
@@ -840,11 +1028,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 44: // Plus +
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* plusEntry = lookupToken(symTable, lexeme);
                     if (!plusEntry) {
-                        plusEntry = newSymbolTableEntry(lexeme, PLUS, 0);
+                        plusEntry = newSymbolTableEntry(lexeme, PLUS);
                         addToken(symTable, plusEntry);
                     }
                     tokenNode = newTokenNode(plusEntry, *lineNum);
@@ -853,11 +1041,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 45: // Minus -
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* minusEntry = lookupToken(symTable, lexeme);
                     if (!minusEntry) {
-                        minusEntry = newSymbolTableEntry(lexeme, MINUS, 0);
+                        minusEntry = newSymbolTableEntry(lexeme, MINUS);
                         addToken(symTable, minusEntry);
                     }
                     tokenNode = newTokenNode(minusEntry, *lineNum);
@@ -866,11 +1054,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 46: // Multiplication *
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* mulEntry = lookupToken(symTable, lexeme);
                     if (!mulEntry) {
-                        mulEntry = newSymbolTableEntry(lexeme, MUL, 0);
+                        mulEntry = newSymbolTableEntry(lexeme, MUL);
                         addToken(symTable, mulEntry);
                     }
                     tokenNode = newTokenNode(mulEntry, *lineNum);
@@ -879,11 +1067,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 47: // Division /
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* divEntry = lookupToken(symTable, lexeme);
                     if (!divEntry) {
-                        divEntry = newSymbolTableEntry(lexeme, DIV, 0);
+                        divEntry = newSymbolTableEntry(lexeme, DIV);
                         addToken(symTable, divEntry);
                     }
                     tokenNode = newTokenNode(divEntry, *lineNum);
@@ -900,10 +1088,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -920,10 +1108,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -932,11 +1120,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 52: // Logical AND &&
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* andEntry = lookupToken(symTable, lexeme);
                     if (!andEntry) {
-                        andEntry = newSymbolTableEntry(lexeme, AND, 0);
+                        andEntry = newSymbolTableEntry(lexeme, AND);
                         addToken(symTable, andEntry);
                     }
                     tokenNode = newTokenNode(andEntry, *lineNum);
@@ -953,10 +1141,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -973,10 +1161,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -985,11 +1173,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 55: // Logical OR ||
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* orEntry = lookupToken(symTable, lexeme);
                     if (!orEntry) {
-                        orEntry = newSymbolTableEntry(lexeme, OR, 0);
+                        orEntry = newSymbolTableEntry(lexeme, OR);
                         addToken(symTable, orEntry);
                     }
                     tokenNode = newTokenNode(orEntry, *lineNum);
@@ -998,11 +1186,11 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 58: // Logical NOT ~
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* notEntry = lookupToken(symTable, lexeme);
                     if (!notEntry) {
-                        notEntry = newSymbolTableEntry(lexeme, NOT, 0);
+                        notEntry = newSymbolTableEntry(lexeme, NOT);
                         addToken(symTable, notEntry);
                     }
                     tokenNode = newTokenNode(notEntry, *lineNum);
@@ -1023,7 +1211,7 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* commonEntry = lookupToken(symTable, lexeme);
                     if (commonEntry) {
                         tokenNode = newTokenNode(commonEntry, *lineNum);
@@ -1031,12 +1219,12 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     }
                     Token tk = findKeyword(keywordTrie, lexeme);
                     if (tk == TK_NOT_FOUND) {
-                        SymbolTableEntry* fldEntry = newSymbolTableEntry(lexeme, FIELDID, 0);
+                        SymbolTableEntry* fldEntry = newSymbolTableEntry(lexeme, FIELDID);
                         addToken(symTable, fldEntry);
                         tokenNode = newTokenNode(fldEntry, *lineNum);
                         return tokenNode;
                     } else {
-                        SymbolTableEntry* keyEntry = newSymbolTableEntry(lexeme, tk, 0);
+                        SymbolTableEntry* keyEntry = newSymbolTableEntry(lexeme, tk);
                         addToken(symTable, keyEntry);
                         tokenNode = newTokenNode(keyEntry, *lineNum);
                         return tokenNode;
@@ -1053,23 +1241,23 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* commonEntry = lookupToken(symTable, lexeme);
                     if (commonEntry) {
                         tokenNode = newTokenNode(commonEntry, *lineNum);
                         return tokenNode;
                     }
-                    SymbolTableEntry* idEntry = newSymbolTableEntry(lexeme, ID, 0);
+                    SymbolTableEntry* idEntry = newSymbolTableEntry(lexeme, ID);
                     addToken(symTable, idEntry);
                     tokenNode = newTokenNode(idEntry, *lineNum);
                     return tokenNode;
                 }
-                if (getLexemeLength(beginPtr, *forwardPtr) > 20) {
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                if (getLexemeLength(*beginPtr, *forwardPtr) > 20) {
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     lexeme[20] = '.'; lexeme[21] = '.'; lexeme[22] = '.'; lexeme[23] = '\0';
                     SymbolTableEntry* idLenEntry = lookupToken(symTable, lexeme);
                     if (!idLenEntry) {
-                        idLenEntry = newSymbolTableEntry(lexeme, ID_LENGTH_EXC, 0);
+                        idLenEntry = newSymbolTableEntry(lexeme, ID_LENGTH_EXC);
                         addToken(symTable, idLenEntry);
                     }
                     tokenNode = newTokenNode(idLenEntry, *lineNum);
@@ -1094,21 +1282,21 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* idEntry = lookupToken(symTable, lexeme);
                     if (!idEntry) {
-                        idEntry = newSymbolTableEntry(lexeme, ID, 0);
+                        idEntry = newSymbolTableEntry(lexeme, ID);
                         addToken(symTable, idEntry);
                     }
                     tokenNode = newTokenNode(idEntry, *lineNum);
                     return tokenNode;
                 }
-                if (getLexemeLength(beginPtr, *forwardPtr) > 20) {
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                if (getLexemeLength(*beginPtr, *forwardPtr) > 20) {
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     lexeme[20] = '.'; lexeme[21] = '.'; lexeme[22] = '.'; lexeme[23] = '\0';
                     SymbolTableEntry* idLenEntry = lookupToken(symTable, lexeme);
                     if (!idLenEntry) {
-                        idLenEntry = newSymbolTableEntry(lexeme, ID_LENGTH_EXC, 0);
+                        idLenEntry = newSymbolTableEntry(lexeme, ID_LENGTH_EXC);
                         addToken(symTable, idLenEntry);
                     }
                     tokenNode = newTokenNode(idLenEntry, *lineNum);
@@ -1133,17 +1321,17 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* entry = lookupToken(symTable, lexeme);
                     if (!entry) {
                         Token tk = findKeyword(keywordTrie, lexeme);
                         if (tk == TK_NOT_FOUND) {
-                            SymbolTableEntry* fldEntry = newSymbolTableEntry(lexeme, FIELDID, 0);
+                            SymbolTableEntry* fldEntry = newSymbolTableEntry(lexeme, FIELDID);
                             addToken(symTable, fldEntry);
                             tokenNode = newTokenNode(fldEntry, *lineNum);
                             return tokenNode;
                         } else {
-                            SymbolTableEntry* keyEntry = newSymbolTableEntry(lexeme, tk, 0);
+                            SymbolTableEntry* keyEntry = newSymbolTableEntry(lexeme, tk);
                             addToken(symTable, keyEntry);
                             tokenNode = newTokenNode(keyEntry, *lineNum);
                             return tokenNode;
@@ -1166,10 +1354,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -1186,23 +1374,23 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* commonEntry = lookupToken(symTable, lexeme);
                     if (commonEntry) {
                         tokenNode = newTokenNode(commonEntry, *lineNum);
                         return tokenNode;
                     }
-                    SymbolTableEntry* funIdEntry = newSymbolTableEntry(lexeme, FUNID, 0);
+                    SymbolTableEntry* funIdEntry = newSymbolTableEntry(lexeme, FUNID);
                     addToken(symTable, funIdEntry);
                     tokenNode = newTokenNode(funIdEntry, *lineNum);
                     return tokenNode;
                 }
-                if (getLexemeLength(beginPtr, *forwardPtr) > 30) {
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                if (getLexemeLength(*beginPtr, *forwardPtr) > 30) {
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     lexeme[30] = '.'; lexeme[31] = '.'; lexeme[32] = '.'; lexeme[33] = '\0';
                     SymbolTableEntry* funLenEntry = lookupToken(symTable, lexeme);
                     if (!funLenEntry) {
-                        funLenEntry = newSymbolTableEntry(lexeme, FUN_LENGTH_EXC, 0);
+                        funLenEntry = newSymbolTableEntry(lexeme, FUN_LENGTH_EXC);
                         addToken(symTable, funLenEntry);
                     }
                     tokenNode = newTokenNode(funLenEntry, *lineNum);
@@ -1227,23 +1415,23 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* commonEntry = lookupToken(symTable, lexeme);
                     if (commonEntry) {
                         tokenNode = newTokenNode(commonEntry, *lineNum);
                         return tokenNode;
                     }
-                    SymbolTableEntry* funIdEntry = newSymbolTableEntry(lexeme, FUNID, 0);
+                    SymbolTableEntry* funIdEntry = newSymbolTableEntry(lexeme, FUNID);
                     addToken(symTable, funIdEntry);
                     tokenNode = newTokenNode(funIdEntry, *lineNum);
                     return tokenNode;
                 }
-                if (getLexemeLength(beginPtr, *forwardPtr) > 30) {
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                if (getLexemeLength(*beginPtr, *forwardPtr) > 30) {
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     lexeme[30] = '.'; lexeme[31] = '.'; lexeme[32] = '.'; lexeme[33] = '\0';
                     SymbolTableEntry* funLenEntry = lookupToken(symTable, lexeme);
                     if (!funLenEntry) {
-                        funLenEntry = newSymbolTableEntry(lexeme, FUN_LENGTH_EXC, 0);
+                        funLenEntry = newSymbolTableEntry(lexeme, FUN_LENGTH_EXC);
                         addToken(symTable, funLenEntry);
                     }
                     tokenNode = newTokenNode(funLenEntry, *lineNum);
@@ -1270,10 +1458,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* fnEntry = lookupToken(symTable, lexeme);
                     if (!fnEntry) {
-                        fnEntry = newSymbolTableEntry(lexeme, FUNID, 0);
+                        fnEntry = newSymbolTableEntry(lexeme, FUNID);
                         addToken(symTable, fnEntry);
                     }
                     tokenNode = newTokenNode(fnEntry, *lineNum);
@@ -1294,10 +1482,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* fnEntry = lookupToken(symTable, lexeme);
                     if (!fnEntry) {
-                        fnEntry = newSymbolTableEntry(lexeme, FUNID, 0);
+                        fnEntry = newSymbolTableEntry(lexeme, FUNID);
                         addToken(symTable, fnEntry);
                     }
                     tokenNode = newTokenNode(fnEntry, *lineNum);
@@ -1318,10 +1506,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* fnEntry = lookupToken(symTable, lexeme);
                     if (!fnEntry) {
-                        fnEntry = newSymbolTableEntry(lexeme, FUNID, 0);
+                        fnEntry = newSymbolTableEntry(lexeme, FUNID);
                         addToken(symTable, fnEntry);
                     }
                     tokenNode = newTokenNode(fnEntry, *lineNum);
@@ -1340,10 +1528,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* mainEntry = lookupToken(symTable, lexeme);
                     if (!mainEntry) {
-                        mainEntry = newSymbolTableEntry(lexeme, MAIN, 0);
+                        mainEntry = newSymbolTableEntry(lexeme, MAIN);
                         addToken(symTable, mainEntry);
                     }
                     tokenNode = newTokenNode(mainEntry, *lineNum);
@@ -1360,10 +1548,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -1378,10 +1566,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* ruidEntry = lookupToken(symTable, lexeme);
                     if (!ruidEntry) {
-                        ruidEntry = newSymbolTableEntry(lexeme, RUID, 0);
+                        ruidEntry = newSymbolTableEntry(lexeme, RUID);
                         addToken(symTable, ruidEntry);
                     }
                     tokenNode = newTokenNode(ruidEntry, *lineNum);
@@ -1400,18 +1588,12 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* numEntry = lookupToken(symTable, lexeme);
-                    if (numEntry) {
-                        tokenNode = newTokenNode(numEntry, *lineNum);
-                        return tokenNode;
-                    }
-                    double numVal = 0;
-                    for (int i = 0; lexeme[i]; i++) {
-                        numVal = numVal * 10 + (lexeme[i] - '0');
+                    if (!numEntry) {
+                        numEntry = newSymbolTableEntry(lexeme, NUM);
+                        addToken(symTable, numEntry);
                     }
-                    numEntry = newSymbolTableEntry(lexeme, NUM, numVal);
-                    addToken(symTable, numEntry);
                     tokenNode = newTokenNode(numEntry, *lineNum);
                     return tokenNode;
                 }
@@ -1427,18 +1609,12 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == BUFFER_SZ - 2 ||
                         *forwardPtr == 2 * BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 2)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* numEntry = lookupToken(symTable, lexeme);
-                    if (numEntry) {
-                        tokenNode = newTokenNode(numEntry, *lineNum);
-                        return tokenNode;
-                    }
-                    double val = 0;
-                    for (int i = 0; lexeme[i]; i++) {
-                        val = val * 10 + (lexeme[i] - '0');
+                    if (!numEntry) {
+                        numEntry = newSymbolTableEntry(lexeme, NUM);
+                        addToken(symTable, numEntry);
                     }
-                    numEntry = newSymbolTableEntry(lexeme, NUM, val);
-                    addToken(symTable, numEntry);
                     tokenNode = newTokenNode(numEntry, *lineNum);
                     return tokenNode;
                 }
@@ -1453,10 +1629,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -1473,20 +1649,12 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* rnumEntry = lookupToken(symTable, lexeme);
-                    if (rnumEntry) {
-                        tokenNode = newTokenNode(rnumEntry, *lineNum);
-                        return tokenNode;
+                    if (!rnumEntry) {
+                        rnumEntry = newSymbolTableEntry(lexeme, RNUM);
+                        addToken(symTable, rnumEntry);
                     }
-                    double val = 0;
-                    int i;
-                    for (i = 0; lexeme[i] != '.'; i++) {
-                        val = val * 10 + (lexeme[i] - '0');
-                    }
-                    val += (lexeme[i+1] - '0') / 10.0 + (lexeme[i+2] - '0') / 100.0;
-                    rnumEntry = newSymbolTableEntry(lexeme, RNUM, val);
-                    addToken(symTable, rnumEntry);
                     tokenNode = newTokenNode(rnumEntry, *lineNum);
                     return tokenNode;
                 }
@@ -1503,10 +1671,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -1523,10 +1691,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -1543,10 +1711,10 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                     if (*forwardPtr < 0) *forwardPtr += 2 * BUFFER_SZ;
                     if (*forwardPtr == BUFFER_SZ - 1 || *forwardPtr == 2 * BUFFER_SZ - 1)
                         retractFlag = true;
-                    extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                    extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                     SymbolTableEntry* errEntry = lookupToken(symTable, lexeme);
                     if (!errEntry) {
-                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR, 0);
+                        errEntry = newSymbolTableEntry(lexeme, LEXICAL_ERROR);
                         addToken(symTable, errEntry);
                     }
                     tokenNode = newTokenNode(errEntry, *lineNum);
@@ -1555,30 +1723,13 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
                 break;
 
             case 26: // Real number with exponent complete
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* rnumEntry = lookupToken(symTable, lexeme);
-                    if (rnumEntry) {
-                        tokenNode = newTokenNode(rnumEntry, *lineNum);
-                        return tokenNode;
+                    if (!rnumEntry) {
+                        rnumEntry = newSymbolTableEntry(lexeme, RNUM);
+                        addToken(symTable, rnumEntry);
                     }
-                    double val = 0;
-                    int i;
-                    for (i = 0; lexeme[i] != '.'; i++) {
-                        val = val * 10 + (lexeme[i] - '0');
-                    }
-                    val += (lexeme[i+1] - '0') / 10.0 + (lexeme[i+2] - '0') / 100.0;
-                    int exp = 0;
-                    i += 4;
-                    if (isdigit(lexeme[i]))
-                        exp = lexeme[i] * 10 + lexeme[i+1];
-                    else
-                        exp = lexeme[i+1] * 10 + lexeme[i+2];
-                    if (lexeme[i] == '-')
-                        exp = -exp;
-                    val *= pow(10, exp);
-                    rnumEntry = newSymbolTableEntry(lexeme, RNUM, val);
-                    addToken(symTable, rnumEntry);
                     tokenNode = newTokenNode(rnumEntry, *lineNum);
                     return tokenNode;
                 }
@@ -1587,16 +1738,18 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
             // ------------------------- COMMENT STATE -------------------------
             
             case 8: // Comment starting with %
-                extractLexeme(beginPtr, forwardPtr, lexeme, buffer);
+                extractLexeme(*beginPtr, forwardPtr, lexeme, buffer);
                 {
                     SymbolTableEntry* commEntry = lookupToken(symTable, lexeme);
                     if (!commEntry) {
-                        commEntry = newSymbolTableEntry(lexeme, COMMENT, 0);
+                        commEntry = newSymbolTableEntry(lexeme, COMMENT);
                         addToken(symTable, commEntry);
                     }
                     tokenNode = newTokenNode(commEntry, *lineNum);
-                    for (; (ch = fetchNextChar(fp, buffer, forwardPtr)) != '\n'; );
-                    ++(*lineNum);
+                    // Skipping may reload the half the '%' is in, so take the span now
+                    tokenNode->loc = tokenSpan(*beginPtr, commEntry);
+                    if (skipToLineEnd(fp, buffer, forwardPtr) == '\n')
+                        ++(*lineNum);
                     return tokenNode;
                 }
                 break;
@@ -1608,6 +1761,20 @@ TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum,
     }
 }
 
+TokenNode* getNextToken(FILE* fp, char *buffer, int *forwardPtr, int *lineNum, 
+                          Trie* keywordTrie, SymbolTable* symTable) {
+    /*
+       Recognizes the next token and records where it starts in the source.
+       The span length is the lexeme length, so a comment token covers
+       only its '%' and the end-of-input marker is empty.
+    */
+    int beginPtr;
+    TokenNode* tokenNode = scanToken(fp, buffer, forwardPtr, lineNum, keywordTrie, symTable, &beginPtr);
+    if (tokenNode && tokenNode->loc == NO_SOURCE_LOC)
+        tokenNode->loc = tokenSpan(beginPtr, tokenNode->entry);
+    return tokenNode;
+}
+
 // ========================= SECTION 4: INITIALIZATION FUNCTIONS =========================
 
 // ------------------------- KEYWORD & TOKEN STRING INITIALIZATION -------------------------
@@ -1645,13 +1812,12 @@ void setupKeywordTrie(Trie* keywordTrie) {
     addKeyword(keywordTrie, "else", ELSE);
 }
 
-void initTokenStrings() {
+static pthread_once_t tokenStringsOnce = PTHREAD_ONCE_INIT;
+
+static void fillTokenStrings() {
     /*
-       Initializes the tokenToString array so that each token enum value maps
-       to its corresponding string. This aids in debugging and token printing.
+       Maps each token enum value to its name. Runs once, under tokenStringsOnce.
     */
-    if (tkStrInitialized) return;
-    tkStrInitialized = true;
     for (int i = 0; i < TK_NOT_FOUND; i++) {
         tokenToString[i] = malloc(TOKEN_STR_LEN);
     }
@@ -1719,25 +1885,39 @@ void initTokenStrings() {
     tokenToString[FUN_LENGTH_EXC] = "FUNCTION_NAME_LENGTH_EXCEEDED";
 }
 
+void initTokenStrings() {
+    /*
+       Initializes the tokenToString array so that each token enum value maps
+       to its corresponding string. This aids in debugging and token printing.
+       Safe to call from any number of threads.
+    */
+    pthread_once(&tokenStringsOnce, fillTokenStrings);
+}
+
 // ========================= SECTION 5: TOKEN LIST GENERATION =========================
 
 // ------------------------- TOKEN LIST GENERATION -------------------------
 
-TokenList* getAllTokens(FILE* fp) {
+static TokenBuffer* collectTokens(FILE* fp, SourceFileId fileId, SymbolTable* symTable) {
     /*
        Retrieves all tokens from the input file by repeatedly invoking the DFA.
-       Returns a TokenList containing the ordered tokens.
+       Returns a TokenBuffer containing the ordered tokens and their spans,
+       or NULL if a token could not be stored (a full shared table).
     */
     char twinBuffer[BUFFER_SZ * 2];
     int fwdPtr = 2 * BUFFER_SZ - 1;
     int lineNumber = 1;
+    bufferOffset[0] = 0;
+    bufferOffset[1] = -BUFFER_SZ;
+    currentSourceFile = fileId;
 
     Trie* keywordTrie = initTrie();
     setupKeywordTrie(keywordTrie);
     initTokenStrings();
 
-    SymbolTable* symTable = newSymbolTable();
-    TokenList* tokenList = createTokenList();
+    TokenBuffer* tokenBuffer = createTokenBuffer(symTable, true);
+    if (!symTable || !tokenBuffer)
+        return NULL;
 
     while (true) {
         TokenNode* tkNode = getNextToken(fp, twinBuffer, &fwdPtr, &lineNumber, keywordTrie, symTable);
@@ -1745,11 +1925,35 @@ TokenList* getAllTokens(FILE* fp) {
             printf("No token retrieved\n");
             break;
         }
-        appendTokenNode(tokenList, tkNode);
-        if (tkNode->entry->tokenType == DOLLAR)
+        bool stored = appendToken(tokenBuffer, tkNode->entry, tkNode->lineNum, tkNode->loc);
+        Token tk = tkNode->entry->tokenType;
+        poolFree(&tokenNodePool, tkNode);
+        if (!stored) {
+            fprintf(stderr, "Lexing stopped at line %d: the token could not be stored\n", lineNumber);
+            freeTokenBuffer(tokenBuffer);
+            return NULL;
+        }
+        if (tk == DOLLAR)
             break;
     }
-    return tokenList;
+    return tokenBuffer;
+}
+
+TokenBuffer* getAllTokens(FILE* fp, SourceFileId fileId) {
+    /*
+       Lexes the file into a buffer with its own symbol table.
+    */
+    return collectTokens(fp, fileId, newSymbolTable());
+}
+
+TokenBuffer* getAllTokensShared(FILE* fp, SourceFileId fileId, InternTable* symbols) {
+    /*
+       Lexes the file into a buffer whose symbols are interned in a table
+       shared with other threads. Call initTokenStrings() before starting
+       the threads; everything else the lexer keeps is per thread.
+       Returns NULL once the table has no free slot for a new lexeme.
+    */
+    return collectTokens(fp, fileId, newSharedSymbolTable(symbols));
 }
 
 // ========================= SECTION 6: COMMENT HANDLING & TOKEN DISPLAY =========================
@@ -1779,40 +1983,41 @@ void removeComments(char* sourceFile, char* cleanFile) {
     fclose(inFile);
 }
 
-void displayTokenList(TokenList* list) {
+void displayTokenList(TokenBuffer* tokens) {
     /*
-       Prints the token list to the console.
+       Prints the token buffer to the console.
        Uses the tokenToString mapping to display token names.
     */
-    TokenNode* current = list->head;
-    while (current != NULL) {
-        char* tokenStr;
-        if (current->entry->tokenType < LEXICAL_ERROR)
-            tokenStr = strdup(tokenToString[current->entry->tokenType]);
-        else if (current->entry->tokenType == LEXICAL_ERROR)
-            tokenStr = strdup("Unrecognized pattern");
-        else if (current->entry->tokenType == ID_LENGTH_EXC)
-            tokenStr = strdup("Identifier length exceeded 20");
-        else if (current->entry->tokenType == FUN_LENGTH_EXC)
-            tokenStr = strdup("Function name length exceeded 30");
+    for (int i = 0; i < tokens->count; i++) {
+        Token tk = (Token) tokens->kind[i];
+        const char* tokenStr;
+        if (tk < LEXICAL_ERROR)
+            tokenStr = tokenToString[tk];
+        else if (tk == LEXICAL_ERROR)
+            tokenStr = "Unrecognized pattern";
+        else if (tk == ID_LENGTH_EXC)
+            tokenStr = "Identifier length exceeded 20";
+        else if (tk == FUN_LENGTH_EXC)
+            tokenStr = "Function name length exceeded 30";
         else
-            tokenStr = strdup("");
+            tokenStr = "";
+        SymbolTableEntry* entry = getTokenEntry(tokens, i);
         printf("Line No: %5d \t Lexeme: %35s \t Token: %35s\n",
-               current->lineNum, current->entry->lexeme, tokenStr);
-        current = current->next;
+               (int) tokens->lineNum[i], entry ? entry->lexeme : "", tokenStr);
     }
 }
 
-TokenList* lexInput(FILE* fp, char* outputPath) {
+TokenBuffer* lexInput(FILE* fp, char* outputPath, SourceFileId fileId) {
     /*
        Wrapper function for the lexical analysis phase.
-       Verifies the input file and returns the generated token list.
+       Verifies the input file and returns the generated token buffer.
+       Token spans refer to fileId, as returned by registerSourceFile().
     */
     if (!fp) {
         printf("Error: Input file not found for lexical analysis\n");
         exit(-1);
     }
-    TokenList* tokens = getAllTokens(fp);
+    TokenBuffer* tokens = getAllTokens(fp, fileId);
     if (!tokens) {
         printf("Error: Failed to retrieve token list\n");
         exit(-1);
@@ -35,28 +35,43 @@ Token findKeyword(Trie* trie, const char* word);
 // Create and initialize a new symbol table.
 SymbolTable* newSymbolTable();
 
-// Insert a symbol table entry into the symbol table.
-void addToken(SymbolTable* table, SymbolTableEntry* entry);
+// Create a symbol table that interns into a table shared between threads.
+SymbolTable* newSharedSymbolTable(struct InternTable* shared);
+
+// Insert a symbol table entry into the symbol table; false if it got no id.
+bool addToken(SymbolTable* table, SymbolTableEntry* entry);
 
 // Create a new symbol table entry for a lexeme.
-SymbolTableEntry* newSymbolTableEntry(char* lexeme, Token tkType, double numericVal);
+SymbolTableEntry* newSymbolTableEntry(char* lexeme, Token tkType);
+
+// Get the numeric value of a NUM/RNUM entry, converting its lexeme on first use.
+double getNumericValue(SymbolTableEntry* entry);
+
+// Get the entry with the given symbol id; NULL if there is none.
+SymbolTableEntry* getSymbolEntry(SymbolTable* table, uint32_t id);
 
 // Search for a lexeme in the symbol table.
 SymbolTableEntry* lookupToken(SymbolTable* table, char* lexeme);
 
-/* ----------- Token List Functions ----------- */
-// Create a new token list for storing tokens.
-TokenList* createTokenList();
-
+/* ----------- Token Buffer Functions ----------- */
 // Create a new token node containing the given symbol table entry and line number.
 TokenNode* newTokenNode(SymbolTableEntry* entry, int lineNum);
 
-// Append a token node to the token list.
-void appendTokenNode(TokenList* list, TokenNode* node);
+// Create an empty token buffer whose symbol ids refer to the given table.
+TokenBuffer* createTokenBuffer(SymbolTable* symbols, bool withSpans);
+
+// Append a token to the token buffer; false if it could not be stored.
+bool appendToken(TokenBuffer* buf, SymbolTableEntry* entry, int lineNum, SourceLoc span);
+
+// Get the symbol table entry of the token at the given index.
+SymbolTableEntry* getTokenEntry(TokenBuffer* buf, int index);
+
+// Release the arrays of a token buffer.
+void freeTokenBuffer(TokenBuffer* buf);
 
 /* -------- Lexical Analysis Core & Utilities -------- */
-// Wrapper function: reads input and returns a list of tokens.
-TokenList* lexInput(FILE* fp, char* outputPath);
+// Wrapper function: reads input and returns a buffer of tokens with spans in the given file.
+TokenBuffer* lexInput(FILE* fp, char* outputPath, SourceFileId fileId);
 
 // Remove comments from the source file and optionally write to a clean file.
 void removeComments(char* sourceFile, char* cleanFile);
@@ -64,8 +79,12 @@ void removeComments(char* sourceFile, char* cleanFile);
 // Print the contents of the clean file (post-comment removal).
 void printCleanFile(const char* cleanFile);
 
-// Generate the complete token list from the input file.
-TokenList* getAllTokens(FILE* fp);
+// Generate the complete token buffer from the input file.
+TokenBuffer* getAllTokens(FILE* fp, SourceFileId fileId);
+
+// Generate the token buffer of a file, interning its symbols in a shared table;
+// NULL if the table fills up.
+TokenBuffer* getAllTokensShared(FILE* fp, SourceFileId fileId, struct InternTable* symbols);
 
 // Populate the trie with all reserved keywords.
 void setupKeywordTrie(Trie* keywordTrie);
@@ -79,10 +98,13 @@ void extractLexeme(int beginPtr, int* forwardPtr, char* lexeme, char* buffer);
 // Fetch the next character from the twin buffer, handling buffer refills.
 char fetchNextChar(FILE* fp, char *buffer, int *forwardPtr);
 
+// Skip the rest of the current line in the twin buffer; returns '\n', or '\0' at end of input.
+char skipToLineEnd(FILE* fp, char *buffer, int *forwardPtr);
+
 // Initialize the token-to-string mapping array.
 void initTokenStrings();
 
-// Print the token list on the console for debugging.
-void displayTokenList(TokenList* list);
+// Print the token buffer on the console for debugging.
+void displayTokenList(TokenBuffer* tokens);
 
 #endif
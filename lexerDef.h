@@ -14,12 +14,16 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include "sourceLoc.h"
 
 /* Constant Definitions */
 #define ALPHABET_COUNT            26     // Number of lowercase letters (for trie)
 #define INIT_SYMBOL_TABLE_CAP     10     // Initial capacity for the symbol table
 #define BUFFER_SZ                 256    // Size of each half of the twin buffer
 #define TOKEN_STR_LEN             50     // Maximum length for token string names
+#define INIT_TOKEN_BUFFER_CAP     256    // Initial capacity of the token buffer
+#define NO_SYMBOL_ID              UINT32_MAX  // Id of an entry not yet added to a symbol table
 
 /* Token Enumeration - DO NOT change token names */
 typedef enum Token {
@@ -90,7 +94,6 @@ typedef enum Token {
 
 /* Global variables for token-to-string mapping and debugging */
 extern char* tokenToString[TK_NOT_FOUND];
-extern bool tkStrInitialized;  // Flag to avoid reinitializing token strings
 extern bool debugPrint;        // Flag to control debug/verbose output
 
 /* ------------------ Trie Structures ------------------ */
@@ -108,32 +111,49 @@ typedef struct Trie {
 
 /* ---------------- Symbol Table Structures ---------------- */
 // SymbolTableEntry: Holds details for a lexeme and its token.
+// Entries are variable-length: the lexeme is stored inline right after the
+// fixed fields and sized to fit, so always allocate them with newSymbolTableEntry().
 typedef struct SymbolTableEntry {
-    char lexeme[BUFFER_SZ];   // The lexeme string
+    double numericValue;      // Numeric value for numbers, valid once valueReady is set
     Token tokenType;          // Token type as defined in the enum
-    double numericValue;      // Stores numeric value for numbers (if applicable)
+    uint32_t id;              // Position of the entry in its symbol table
+    unsigned short length;    // Length of the lexeme (excluding the terminator)
+    bool valueReady;          // Set once getNumericValue() has converted the lexeme
+    char lexeme[];            // The lexeme string, stored inline
 } SymbolTableEntry;
 
 // SymbolTable: A dynamic array of pointers to SymbolTableEntry.
+// A table created with newSharedSymbolTable() is instead a view of an
+// InternTable shared between threads: it has no entries array of its own,
+// ids are slot indexes, and getSymbolEntry() reads the slots atomically.
 typedef struct SymbolTable {
     int capacity;                    // Maximum number of entries allocated
-    int size;                        // Current number of entries
-    SymbolTableEntry** entries;      // Array of pointers to entries
+    int size;                        // Current number of entries (slots for a shared table)
+    SymbolTableEntry** entries;      // Array of pointers to entries, NULL for a shared table
+    struct InternTable* shared;      // Backing intern table, or NULL for a per-file table
 } SymbolTable;
 
-/* -------------- Token Linked List Structures -------------- */
-// TokenNode: Node for storing token information in a linked list.
+/* -------------- Token Structures -------------- */
+// TokenNode: A single token as recognized by the DFA.
 typedef struct TokenNode {
     SymbolTableEntry* entry;   // Pointer to the symbol table entry for the token
     int lineNum;               // Line number in the source code where token was found
-    struct TokenNode* next;    // Pointer to the next token node
+    SourceLoc loc;             // Span of the token in the source
 } TokenNode;
 
-// TokenList: Linked list to maintain the order of tokens.
-typedef struct TokenList {
-    int count;           // Total number of tokens in the list
-    TokenNode* head;     // Pointer to the first token node
-    TokenNode* tail;     // Pointer to the last token node
-} TokenList;
+// TokenBuffer: Contiguous token storage kept as parallel arrays.
+// A sequential scan over token kinds touches one byte per token, and the
+// symbol table entry is only loaded when the lexeme itself is needed.
+typedef struct TokenBuffer {
+    int count;               // Total number of tokens in the buffer
+    int capacity;            // Number of slots allocated in each array
+    uint8_t* kind;           // Token type of each token
+    uint32_t* symbolId;      // Id of each token's entry in the symbol table
+    uint32_t* lineNum;       // Line number of each token
+    SourceLoc* span;         // Optional source span of each token (NULL when not tracked)
+    SymbolTable* symbols;    // Symbol table that symbolId refers to
+    void* mappedBase;        // Mapping backing the arrays when read from a token stream (else NULL)
+    size_t mappedSize;       // Size of that mapping
+} TokenBuffer;
 
 #endif
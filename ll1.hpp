@@ -0,0 +1,190 @@
+/*
+   ====================================================================
+   Compile-Time LL(1) Tables - C++20 Header-Only Front End
+   --------------------------------------------------------------------
+   Builds FIRST/FOLLOW sets and the dense LL(1) table of a grammar
+   given as a constexpr rule list, entirely during compilation:
+
+     inline constexpr ll1::Rule rules[] = {
+         ll1::rule(program, otherFunctions, mainFunction),
+         ll1::rule(otherFunctions, EPS),
+         ...
+     };
+     using Tables = ll1::Tables<rules, NT_NOT_FOUND, program>;
+     static_assert(Tables::table[...] == ...);
+
+   Tables::table is a static constexpr array in the layout of ruleTable
+   (rule index + 1 per [non-terminal][token] cell, NO_RULE for errors),
+   so the compiler can fold lookups with constant operands and nothing
+   is computed at startup. A grammar that is not LL(1) fails to compile
+   on a static_assert in ll1::ConflictInParseTable, whose template
+   arguments in the diagnostic give the non-terminal, the token and
+   the two rules that claim the cell.
+
+   The algorithms follow parser.c: a terminal EPS on a right-hand side
+   derives the empty string, and the first rule claiming a cell keeps it.
+   ====================================================================
+*/
+
+#ifndef LL1_HPP
+#define LL1_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "parserDef.h"
+
+namespace ll1 {
+
+/* Constant Definitions */
+constexpr std::size_t MAX_RHS = 16;   // Longest right-hand side a Rule holds
+
+// Rule: One grammar rule as symbol codes.
+struct Rule {
+    SymbolCode lhs;                          // NT_CODE of the left-hand side
+    std::size_t length;                      // Number of right-hand side symbols
+    std::array<SymbolCode, MAX_RHS> rhs;     // Right-hand side, unused slots zero
+};
+
+// Conflict: Where a rule list first fails to be LL(1); found is false if nowhere.
+struct Conflict {
+    bool found;
+    int nonTerminal;
+    int token;
+    int keptRule;
+    int otherRule;
+};
+
+// Symbol code of a grammar symbol
+constexpr SymbolCode code(Token tk) { return (SymbolCode) tk; }
+constexpr SymbolCode code(NonTerminal nt) { return NT_CODE((int) nt); }
+
+// Build a rule from its left-hand side and right-hand side symbols
+template <typename... Symbols>
+constexpr Rule rule(NonTerminal lhs, Symbols... rhs) {
+    static_assert(sizeof...(Symbols) >= 1 && sizeof...(Symbols) <= MAX_RHS,
+                  "a rule needs between 1 and ll1::MAX_RHS right-hand side symbols");
+    return Rule{ code(lhs), sizeof...(Symbols), { code(rhs)... } };
+}
+
+// ConflictInParseTable: Fails to compile when Found, naming the cell and
+// the two rules (indices into the rule list) in the instantiation trace.
+template <bool Found, int NonTerminal, int Token, int KeptRule, int OtherRule>
+struct ConflictInParseTable {
+    static_assert(!Found, "grammar is not LL(1): two rules claim the same parse table cell");
+};
+
+// FIRST of a right-hand side suffix; holds EPS when it can derive the empty string
+template <std::size_t NTs>
+constexpr TokenSet firstOfSequence(const Rule& r, std::size_t from, const std::array<TokenSet, NTs>& first) {
+    TokenSet set = 0;
+    for (std::size_t i = from; i < r.length; i++) {
+        SymbolCode c = r.rhs[i];
+        if (!IS_NT_CODE(c))
+            return c == EPS ? set | TOKEN_BIT(EPS) : set | TOKEN_BIT(c);
+        TokenSet f = first[CODE_TO_NT(c)];
+        set |= f & ~TOKEN_BIT(EPS);
+        if (!IN_TOKEN_SET(f, EPS))
+            return set;
+    }
+    return set | TOKEN_BIT(EPS);
+}
+
+// FIRST sets of every non-terminal, by iterating to a fixpoint
+template <std::size_t NTs, std::size_t R>
+constexpr std::array<TokenSet, NTs> computeFirst(const Rule (&rules)[R]) {
+    std::array<TokenSet, NTs> first{};
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (const Rule& r : rules) {
+            TokenSet& lhs = first[CODE_TO_NT(r.lhs)];
+            TokenSet grown = lhs | firstOfSequence(r, 0, first);
+            changed |= grown != lhs;
+            lhs = grown;
+        }
+    }
+    return first;
+}
+
+// FOLLOW sets of every non-terminal, by iterating to a fixpoint
+template <std::size_t NTs, std::size_t R>
+constexpr std::array<TokenSet, NTs> computeFollow(const Rule (&rules)[R], int start,
+                                                  const std::array<TokenSet, NTs>& first) {
+    std::array<TokenSet, NTs> follow{};
+    follow[start] = TOKEN_BIT(DOLLAR);
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (const Rule& r : rules) {
+            for (std::size_t i = 0; i < r.length; i++) {
+                if (!IS_NT_CODE(r.rhs[i]))
+                    continue;
+                TokenSet rest = firstOfSequence(r, i + 1, first);
+                TokenSet& target = follow[CODE_TO_NT(r.rhs[i])];
+                TokenSet grown = target | (rest & ~TOKEN_BIT(EPS));
+                if (IN_TOKEN_SET(rest, EPS))
+                    grown |= follow[CODE_TO_NT(r.lhs)];
+                changed |= grown != target;
+                target = grown;
+            }
+        }
+    }
+    return follow;
+}
+
+// Dense table of the rules in the layout of ruleTable; the first rule
+// claiming a cell keeps it, and the first later claim is recorded
+template <std::size_t NTs, std::size_t R>
+constexpr std::array<RuleIndex, NTs * TK_NOT_FOUND> buildTable(const Rule (&rules)[R],
+                                                               const std::array<TokenSet, NTs>& first,
+                                                               const std::array<TokenSet, NTs>& follow,
+                                                               Conflict* conflict) {
+    std::array<RuleIndex, NTs * TK_NOT_FOUND> table{};
+    for (std::size_t r = 0; r < R; r++) {
+        int lhs = CODE_TO_NT(rules[r].lhs);
+        TokenSet predict = firstOfSequence(rules[r], 0, first);
+        if (IN_TOKEN_SET(predict, EPS))
+            predict |= follow[lhs];
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            if (tk == EPS || !IN_TOKEN_SET(predict, tk))
+                continue;
+            RuleIndex& cell = table[lhs * TK_NOT_FOUND + tk];
+            if (cell == NO_RULE)
+                cell = (RuleIndex)(r + 1);
+            else if (conflict && !conflict->found)
+                *conflict = Conflict{ true, lhs, tk, cell - 1, (int) r };
+        }
+    }
+    return table;
+}
+
+// First cell of the table claimed by two rules
+template <std::size_t NTs, std::size_t R>
+constexpr Conflict findConflict(const Rule (&rules)[R], const std::array<TokenSet, NTs>& first,
+                                const std::array<TokenSet, NTs>& follow) {
+    Conflict conflict{};
+    buildTable<NTs>(rules, first, follow, &conflict);
+    return conflict;
+}
+
+// Tables: Everything the parser needs, computed while compiling.
+template <const auto& Rules, std::size_t NTs, int Start>
+struct Tables {
+    static constexpr std::size_t ruleCount = std::size(Rules);
+    static constexpr std::array<TokenSet, NTs> first = computeFirst<NTs>(Rules);
+    static constexpr std::array<TokenSet, NTs> follow = computeFollow<NTs>(Rules, Start, first);
+
+    static constexpr Conflict conflict = findConflict<NTs>(Rules, first, follow);
+    static constexpr ConflictInParseTable<conflict.found, conflict.nonTerminal, conflict.token,
+                                          conflict.keptRule, conflict.otherRule> check{};
+
+    // Dense table in the layout of ruleTable
+    alignas(PARSE_TABLE_ALIGN) static constexpr std::array<RuleIndex, NTs * TK_NOT_FOUND> table = buildTable<NTs>(Rules, first, follow, nullptr);
+
+    // Rule to expand for a non-terminal on a token, NO_RULE for an error
+    static constexpr RuleIndex lookup(int nt, int tk) { return table[nt * TK_NOT_FOUND + tk]; }
+};
+
+}  // namespace ll1
+
+#endif
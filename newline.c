@@ -0,0 +1,81 @@
+/*
+   ====================================================================
+   Newline Scanning Implementation
+   --------------------------------------------------------------------
+   The SSE2 paths compare a 16-byte block against '\n' (and '\0') and
+   turn the result into a bit mask: counting is a popcount of the mask,
+   finding is a count of trailing zeros. Tails shorter than a block are
+   handled one byte at a time.
+   ====================================================================
+*/
+
+#include <string.h>
+#include "newline.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+size_t countNewlines(const char* text, size_t length) {
+    /*
+       Counts line breaks a block at a time.
+    */
+    size_t count = 0;
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(text + i));
+        unsigned mask = (unsigned) _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+        count += (size_t) __builtin_popcount(mask);
+    }
+    for (; i < length; i++)
+        count += text[i] == '\n';
+#else
+    const char* p = text;
+    const char* end = text + length;
+    while ((p = (const char*) memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        count++;
+        p++;
+    }
+#endif
+    return count;
+}
+
+size_t findLineEnd(const char* text, size_t length) {
+    /*
+       Finds the first byte that ends a line comment: a line break or the
+       end-of-input marker the twin buffer stores after the last byte.
+    */
+    size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i*)(text + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, newline), _mm_cmpeq_epi8(block, zero));
+        unsigned mask = (unsigned) _mm_movemask_epi8(hits);
+        if (mask)
+            return i + (size_t) __builtin_ctz(mask);
+    }
+#endif
+    for (; i < length; i++) {
+        if (text[i] == '\n' || text[i] == '\0')
+            return i;
+    }
+    return length;
+}
+
+size_t collectLineStarts(const char* text, size_t length, uint32_t base, uint32_t* starts) {
+    /*
+       Walks the line breaks with memchr, which the C library vectorizes.
+    */
+    size_t count = 0;
+    const char* p = text;
+    const char* end = text + length;
+    while ((p = (const char*) memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        p++;
+        starts[count++] = base + (uint32_t)(p - text);
+    }
+    return count;
+}
@@ -0,0 +1,30 @@
+/*
+   ====================================================================
+   Newline Scanning - Function Prototypes
+   --------------------------------------------------------------------
+   Bulk scans for line breaks, so that code which skips over bytes
+   (comments, mapped files, chunks lexed in parallel) can keep line
+   numbers without looking at every character itself. On x86-64 the
+   scans compare 16 bytes per step with SSE2; elsewhere they fall back
+   to memchr.
+   ====================================================================
+*/
+
+#ifndef NEWLINE_H
+#define NEWLINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Count the '\n' characters in text[0 .. length).
+size_t countNewlines(const char* text, size_t length);
+
+// Find the first '\n' or '\0' in text[0 .. length); returns length when there is none.
+size_t findLineEnd(const char* text, size_t length);
+
+// Store the offset just past every '\n' in text[0 .. length), each plus base,
+// into starts. starts must have room for countNewlines(text, length) values.
+// Returns the number of offsets stored.
+size_t collectLineStarts(const char* text, size_t length, uint32_t base, uint32_t* starts);
+
+#endif
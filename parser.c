@@ -11,33 +11,54 @@
    ====================================================================
 */
 
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #include <ctype.h>
 #include <stdlib.h>
+#include <pthread.h>
 #include "lexer.h"
 #include "lexerDef.h"
 #include "parser.h"
 #include "parserDef.h"
 #include "stack.h"
+#include "arena.h"
+#include "tokenStream.h"
+#include "tokenPack.h"
+#include "grammarCache.h"
+#include "firstFollow.h"
+#include "combTable.h"
+#include "grammarLoader.h"
 
 /* ========================== GLOBAL VARIABLES ========================== */
 
+// With STATIC_GRAMMAR_TABLES the grammar, FIRST/FOLLOW sets, parse table and
+// their initialization flags are defined by the generated grammarTables.c
+#ifndef STATIC_GRAMMAR_TABLES
+
 // Mapping from non-terminal enum values to their string representation
 char* nonTerminalToString[NT_NOT_FOUND];
 
 // Array of grammar rules read from grammar file
-GrammarRule* Grammar[MAX_GRAMMAR_RULES];
+GrammarRule** Grammar;
 int numOfRules = 0;
 
+// Grammar rules as symbol code arrays
+CompiledRule* compiledRules;
+
+// Unit production chains of the parse table cells
+uint32_t* unitChainStart;
+RuleIndex* unitChainRules;
+
 // FIRST and FOLLOW sets for each non-terminal
-FirstFollowSet** First;
-FirstFollowSet** Follow;
-FirstFollowSet** AutoFirst;
-FirstFollowSet** AutoFollow;
+TokenSet* First;
+TokenSet* Follow;
+TokenSet* AutoFirst;
+TokenSet* AutoFollow;
 
 // Parse table: maps [non-terminal][token] -> grammar rule
 GrammarRule*** parseTable;
+RuleIndex* ruleTable;
 
 // Initialization flags
 bool grammarLoaded = false;
@@ -45,6 +66,38 @@ bool nonTerminalsInitialized = false;
 bool firstFollowComputed = false;
 bool parseTreeInitialized = false;
 
+// Hash of the grammar the tables above were built from (0 while none is loaded)
+uint64_t loadedGrammarHash = 0;
+
+#endif
+
+// Parse table lookups go to the comb-vector table when the parser is built
+// with -DCOMB_PARSE_TABLE, to the dense cells of the frozen tables otherwise;
+// with -DCONSTEXPR_PARSE_TABLE those are the cells computed at compile time
+#ifdef COMB_PARSE_TABLE
+static CombTable combParseTable;        // Built without defaults: errors are found as early as before
+#define PARSE_TABLE_LOOKUP(tables, nt, tk)  combLookup(&combParseTable, (nt), (tk))
+#else
+#define PARSE_TABLE_LOOKUP(tables, nt, tk)  (tables)->cells[(nt) * TK_NOT_FOUND + (tk)]
+#endif
+#ifdef CONSTEXPR_PARSE_TABLE
+extern const RuleIndex* const constexprRuleTable;   // Computed by the C++ compiler (constexprTables.cpp)
+extern const uint64_t constexprGrammarHash;         // Grammar constexprRuleTable was computed from
+#endif
+
+// Tables shared by every parsing thread; written once under parserTablesOnce
+static pthread_once_t parserTablesOnce = PTHREAD_ONCE_INIT;
+static pthread_once_t nonTerminalsOnce = PTHREAD_ONCE_INIT;
+static ParserTables frozenTables;
+
+// The entry every EPS leaf prints with, shared by all trees and threads and
+// written once with the tables; the lexeme is stored right behind the fields
+static union {
+    SymbolTableEntry entry;
+    char bytes[sizeof(SymbolTableEntry) + sizeof("EPSILON")];
+} epsilonStorage;
+
+
 /* ========================== STACK OPERATIONS ========================== */
 
 /**
@@ -53,69 +106,30 @@ bool parseTreeInitialized = false;
  * @return A pointer to the newly created stack
  */
 Stack* initializeStack() {
-    Stack* newStack = (Stack*)malloc(sizeof(Stack));
-    if (!newStack) {
-        fprintf(stderr, "Memory allocation failure for new stack\n");
-        exit(-1);
-    }
+    Stack* newStack = (Stack*)arenaAlloc(&compilationArena, sizeof(Stack));
     
-    // Initialize with an empty stack (null top pointer)
-    newStack->top = NULL;
+    // Start empty, with room for INIT_STACK_CAPACITY entries
+    newStack->items = (uint32_t*)arenaAlloc(&compilationArena, INIT_STACK_CAPACITY * sizeof(uint32_t));
+    newStack->size = 0;
+    newStack->capacity = INIT_STACK_CAPACITY;
     return newStack;
 }
 
 /**
- * Adds a parse tree node to the top of the stack
- * 
- * @param stack The stack to push onto
- * @param node The parse tree node to push
- */
-void pushStack(Stack* stack, ParseNode* node) {
-    // Allocate memory for new stack item
-    StackItem* newItem = (StackItem*)malloc(sizeof(StackItem));
-    if (!newItem) {
-        fprintf(stderr, "Memory allocation failure while creating new stack item\n");
-        exit(-1);
-    }
-    
-    // Set up the new stack item and adjust the top pointer
-    newItem->data = node;
-    newItem->next = stack->top;
-    stack->top = newItem;
-}
-
-/**
- * Removes the top element from the stack
- * 
- * @param stack The stack to pop from
- */
-void popStack(Stack* stack) {
-    if (!isStackEmpty(stack)) {
-        // Save the top item, update the top pointer, then free the old top
-        StackItem* temp = stack->top;
-        stack->top = stack->top->next;
-        free(temp);
-    }
-}
-
-/**
- * Returns the top element of the stack without removing it
- * 
- * @param stack The stack to peek at
- * @return The parse tree node at the top of the stack, or NULL if empty
- */
-ParseNode* peekStack(Stack* stack) {
-    return isStackEmpty(stack) ? NULL : stack->top->data;
-}
-
-/**
- * Checks if the stack is empty
+ * Grows the stack until count more entries fit, doubling its capacity
  * 
- * @param stack The stack to check
- * @return true if the stack is empty, false otherwise
+ * @param stack The stack to grow
+ * @param count The number of entries about to be pushed
  */
-bool isStackEmpty(Stack* stack) {
-    return (stack->top == NULL);
+void growStack(Stack* stack, int count) {
+    // Copy into a fresh array from the arena; the old one goes with the arena
+    int capacity = stack->capacity * 2;
+    while (capacity < stack->size + count)
+        capacity *= 2;
+    uint32_t* grown = (uint32_t*)arenaAlloc(&compilationArena, capacity * sizeof(uint32_t));
+    memcpy(grown, stack->items, stack->size * sizeof(uint32_t));
+    stack->items = grown;
+    stack->capacity = capacity;
 }
 
 /* ========================== GRAMMAR SYMBOL OPERATIONS ========================== */
@@ -128,11 +142,7 @@ bool isStackEmpty(Stack* stack) {
  */
 SymbolNode* createSymbolNode(SymbolUnit* su) {
     // Allocate memory for the new node
-    SymbolNode* newNode = (SymbolNode*)malloc(sizeof(SymbolNode));
-    if (!newNode) {
-        fprintf(stderr, "Could not allocate memory for symbol node\n");
-        return NULL;
-    }
+    SymbolNode* newNode = (SymbolNode*)arenaAlloc(&grammarArena, sizeof(SymbolNode));
     
     // Initialize the new node
     newNode->prev = NULL;
@@ -149,11 +159,7 @@ SymbolNode* createSymbolNode(SymbolUnit* su) {
  */
 SymbolList* createSymbolList() {
     // Allocate memory for the list structure
-    SymbolList* newList = (SymbolList*)malloc(sizeof(SymbolList));
-    if (!newList) {
-        fprintf(stderr, "Could not allocate memory for Symbol List\n");
-        return NULL;
-    }
+    SymbolList* newList = (SymbolList*)arenaAlloc(&grammarArena, sizeof(SymbolList));
     
     // Initialize the list as empty
     newList->count = 0;
@@ -187,99 +193,128 @@ void insertSymbolNode(SymbolList* symList, SymbolNode* node) {
 /* ========================== PARSE TREE OPERATIONS ========================== */
 
 /**
- * Creates a new node for the parse tree
- * 
- * @return A pointer to the newly created parse node
- */
-ParseNode* createParseNode() {
-    // Allocate memory for the node
-    ParseNode* newNode = (ParseNode*)malloc(sizeof(ParseNode));
-    if (!newNode) {
-        fprintf(stderr, "Could not allocate memory for parse tree node\n");
-        return NULL;
-    }
-    
-    // Allocate memory for children array with initial capacity
-    newNode->children = (ParseNode**)malloc(INIT_CHILD_CAPACITY * sizeof(ParseNode*));
-    if (!(newNode->children)) {
-        fprintf(stderr, "Could not allocate memory for parse tree node's children\n");
-        return newNode;  // Return partial node, caller should check children != NULL
-    }
-    
-    // Initialize the node's fields
-    newNode->capacity = INIT_CHILD_CAPACITY;
-    newNode->size = 0;
-    newNode->symbol = NULL;
-    newNode->ste = NULL;
-    newNode->lineNumber = -1;
-    
-    // Initialize children array to NULL pointers
-    for (int i = 0; i < INIT_CHILD_CAPACITY; i++) {
-        newNode->children[i] = NULL;
-    }
-    
-    return newNode;
-}
-
-/**
- * Creates a new parse tree with an initialized root node
- * 
+ * Creates a new parse tree holding only its root, a <program> node
+ *
+ * @param symbols The symbol table the terminals' symbol ids will refer to
  * @return A pointer to the newly created parse tree
  */
-ParseTree* createParseTree() {
-    // Allocate memory for the tree structure
+ParseTree* createParseTree(SymbolTable* symbols) {
     ParseTree* newTree = (ParseTree*)malloc(sizeof(ParseTree));
-    if (!newTree) {
-        fprintf(stderr, "Could not allocate memory for creating parse tree\n");
+    ParseNode* nodes = (ParseNode*)malloc(INIT_PARSE_TREE_CAPACITY * sizeof(ParseNode));
+    if (!newTree || !nodes) {
+        fprintf(stderr, "Memory allocation failed for the parse tree\n");
+        free(newTree);
+        free(nodes);
         return NULL;
     }
-    
-    // Create root node for the tree
-    newTree->root = createParseNode();
-    
+    newTree->nodes = nodes;
+    newTree->count = 1;
+    newTree->capacity = INIT_PARSE_TREE_CAPACITY;
+    newTree->symbols = symbols;
+    newTree->elideEpsilonLeaves = false;
+    
+    // The root is node 0
+    nodes[PARSE_TREE_ROOT] = (ParseNode){ NT_CODE(program), 0, NO_PARSE_NODE, NO_SYMBOL_ID, 0 };
     return newTree;
 }
 
 /**
- * Adds a child node to a parent node in the parse tree
- * 
- * @param parent The parent node
- * @param child The child node to add
+ * Releases a parse tree and all of its nodes
+ *
+ * @param tree The tree to release
  */
-void insertChild(ParseNode* parent, ParseNode* child) {
-    // Validate parameters
-    if (!parent) {
-        fprintf(stderr, "Parent node is NULL. Cannot add child.\n");
+void freeParseTree(ParseTree* tree) {
+    if (!tree)
         return;
-    }
-    if (!child) {
-        fprintf(stderr, "Child node is NULL. Cannot add child.\n");
-        return;
-    }
-    
-    // Check if we need to resize the children array
-    if (parent->size == parent->capacity) {
-        // Double the capacity
-        parent->capacity *= 2;
-        parent->children = (ParseNode**)realloc(parent->children, 
-                                               parent->capacity * sizeof(ParseNode*));
-        if (!(parent->children)) {
-            fprintf(stderr, "Could not allocate memory for resizing children array\n");
-            return;
+    free(tree->nodes);
+    free(tree);
+}
+
+/**
+ * Gives a node all of its children at once, as count consecutive nodes at
+ * the end of the tree's node array, so that siblings sit side by side.
+ * The array may move: pointers into it must be taken again afterwards
+ *
+ * @param tree The tree the node belongs to
+ * @param parent Index of the node to give children, still without any
+ * @param count The number of children, known from the rule being expanded
+ * @return Index of the first child, or NO_PARSE_NODE if the tree is full
+ */
+uint32_t addChildren(ParseTree* tree, uint32_t parent, int count) {
+    if (tree->count + (uint32_t)count > tree->capacity) {
+        if (tree->capacity > MAX_PARSE_TREE_NODES / 2) {
+            fprintf(stderr, "Parse tree exceeds %u nodes\n", MAX_PARSE_TREE_NODES);
+            return NO_PARSE_NODE;
+        }
+        uint32_t capacity = tree->capacity * 2;
+        ParseNode* grown = (ParseNode*)realloc(tree->nodes, (size_t)capacity * sizeof(ParseNode));
+        if (!grown) {
+            fprintf(stderr, "Failed to resize the parse tree\n");
+            return NO_PARSE_NODE;
         }
+        tree->nodes = grown;
+        tree->capacity = capacity;
     }
     
-    // Add child and increment size
-    parent->children[(parent->size)++] = child;
+    uint32_t first = tree->count;
+    for (int i = 0; i < count; i++)
+        tree->nodes[first + i] = (ParseNode){ EPS, 0, NO_PARSE_NODE, NO_SYMBOL_ID, 0 };
+    tree->count += (uint32_t)count;
+    tree->nodes[parent].firstChild = first;
+    tree->nodes[parent].childCount = (uint16_t)count;
+    return first;
+}
+
+/**
+ * Expands a non-terminal node by a rule: creates one child per RHS symbol
+ * and pushes the children so that the leftmost ends up on top. In a tree
+ * built without EPS leaves an EPS right-hand side adds nothing at all
+ *
+ * @param tree The tree being built
+ * @param stack The parse stack
+ * @param parent Index of the node being expanded, still without children
+ * @param rule The compiled rule to expand by
+ * @return false if the tree could not grow
+ */
+bool expandRule(ParseTree* tree, Stack* stack, uint32_t parent, const CompiledRule* rule) {
+    if (tree->elideEpsilonLeaves && rule->length == 1 && rule->rhs[0] == EPS)
+        return true;
+    
+    // Allocate every child at once
+    uint32_t first = addChildren(tree, parent, rule->length);
+    if (first == NO_PARSE_NODE)
+        return false;
+    reserveStack(stack, rule->length);
+    
+    // Walk the push order: each child is labelled and pushed in the same step
+    ParseNode* children = &tree->nodes[first];
+    for (int i = 0; i < rule->length; i++) {
+        children[rule->length - 1 - i].code = rule->push[i];
+        stack->items[stack->size++] = first + (uint32_t)(rule->length - 1 - i);
+    }
+    return true;
+}
+
+/**
+ * Returns the symbol table entry a node prints with: the matched token's for
+ * a terminal, the shared EPSILON entry for an EPS leaf, else NULL
+ *
+ * @param tree The tree the node belongs to
+ * @param node The node
+ */
+SymbolTableEntry* parseNodeEntry(const ParseTree* tree, const ParseNode* node) {
+    if (node->symbolId != NO_SYMBOL_ID)
+        return getSymbolEntry(tree->symbols, node->symbolId);
+    return node->code == EPS ? &epsilonStorage.entry : NULL;
 }
 
 /* ========================== INITIALIZATION FUNCTIONS ========================== */
 
 /**
- * Initializes the mapping from non-terminal enum values to their string representations
- * This is used for error reporting and debug output
+ * Fills the mapping from non-terminal enum values to their string representations,
+ * unless tables generated at build time already hold it
  */
-void initializeNonTerminalToString() {
+static void fillNonTerminalToString() {
     // Skip if already initialized
     if (nonTerminalsInitialized)
         return;
@@ -347,6 +382,14 @@ void initializeNonTerminalToString() {
     nonTerminalToString[A] = "<A>"; 
 }
 
+/**
+ * Initializes the mapping from non-terminal enum values to their string representations
+ * This is used for error reporting and debug output; safe to call from any thread
+ */
+void initializeNonTerminalToString() {
+    pthread_once(&nonTerminalsOnce, fillNonTerminalToString);
+}
+
 /* ========================== UTILITY FUNCTIONS ========================== */
 
 /**
@@ -379,89 +422,93 @@ NonTerminal getNonTerminalFromString(char* str) {
     return NT_NOT_FOUND;
 }
 
+/**
+ * Hashes the contents of a grammar file with 64-bit FNV-1a, so that tables
+ * built from it can be matched against the grammar later
+ *
+ * @param path The grammar file
+ * @return The hash, or 0 if the file cannot be read
+ */
+uint64_t hashGrammarFile(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return 0;
+    
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned char buff[4096];
+    size_t bytesRead;
+    while ((bytesRead = fread(buff, 1, sizeof(buff), fp)) > 0) {
+        for (size_t i = 0; i < bytesRead; i++) {
+            hash ^= buff[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+    
+    fclose(fp);
+    return hash;
+}
+
 /**
  * Reads grammar rules from a file and loads them into memory
- * Each rule is structured as "LHS RHS_1 RHS_2 ... RHS_n"
+ * Each rule is structured as "LHS RHS_1 RHS_2 ... RHS_n"; the file is read
+ * by the grammar loader and its non-terminals are mapped onto NonTerminal
+ *
+ * @param path The grammar file
+ * @return false if the file could not be loaded or names a non-terminal the
+ *         parser does not know; the error has been printed
  */
-void readGrammar() {
+bool readGrammar(const char* path) {
     // Skip if already loaded
     if (grammarLoaded)
-        return;
+        return true;
         
-    grammarLoaded = true;
-    
-    // Buffer for reading each line of the grammar file
-    char buff[MAX_RULE_LENGTH];
+    initializeNonTerminalToString();
     
-    // Open the grammar file
-    FILE* fp = fopen("grammar.txt", "r");
-    if (!fp) {
-        fprintf(stderr, "Could not open grammar file\n");
-        return;
+    const LoadedGrammar* loaded = loadGrammarFile(path);
+    if (!loaded)
+        return false;
+    
+    // Match the grammar's non-terminals with the parser's by name
+    NonTerminal* ntOf = (NonTerminal*)arenaAlloc(&grammarArena, loaded->nonTerminals * sizeof(NonTerminal));
+    for (int i = 0; i < loaded->nonTerminals; i++)
+        ntOf[i] = NT_NOT_FOUND;
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        int i = findGrammarNonTerminal(loaded, nonTerminalToString[nt]);
+        if (i >= 0)
+            ntOf[i] = (NonTerminal)nt;
     }
-    
-    // For tokenizing the input line
-    char* oneTok;
-    
-    // Process each line (rule) from the grammar file
-    while (fgets(buff, MAX_RULE_LENGTH, fp)) {
-        // Get LHS (left-hand side) of the rule
-        oneTok = strtok(buff, " \t\n\r");
-        
-        // Create a new grammar rule
-        GrammarRule* gRule = (GrammarRule*)malloc(sizeof(GrammarRule));
-        if (!gRule) {
-            fprintf(stderr, "Could not allocate memory for rule\n");
-            return;
+    for (int i = 0; i < loaded->nonTerminals; i++) {
+        if (ntOf[i] == NT_NOT_FOUND) {
+            fprintf(stderr, "Grammar %s uses the unknown non-terminal %s\n", path, loaded->nonTerminalNames[i]);
+            return false;
         }
+    }
+    
+    // Build the rule lists
+    Grammar = (GrammarRule**)arenaAlloc(&grammarArena, loaded->ruleCount * sizeof(GrammarRule*));
+    for (int r = 0; r < loaded->ruleCount; r++) {
+        GrammarRule* gRule = (GrammarRule*)arenaAlloc(&grammarArena, sizeof(GrammarRule));
         
         // Create and set up the LHS symbol
-        gRule->lhs = (SymbolUnit*)malloc(sizeof(SymbolUnit));
-        if (!(gRule->lhs)) {
-            fprintf(stderr, "Could not allocate memory for grammar symbol\n");
-            return;
-        }
+        gRule->lhs = (SymbolUnit*)arenaAlloc(&grammarArena, sizeof(SymbolUnit));
         gRule->lhs->isNonTerminal = true;
-        gRule->lhs->value.nt = getNonTerminalFromString(oneTok);
+        gRule->lhs->value.nt = ntOf[CODE_TO_NT(loaded->ruleLhs[r])];
         
         // Create the right-hand side symbol list
         gRule->rhs = createSymbolList();
-        
-        // Process all tokens on the right-hand side of the rule
-        oneTok = strtok(NULL, " \t\n\r");
-        while (oneTok) {
-            // Create a symbol unit for this RHS token
-            SymbolUnit* su = (SymbolUnit*)malloc(sizeof(SymbolUnit));
-            if (!su) {
-                fprintf(stderr, "Could not allocate memory for RHS grammar symbol\n");
-                break;
-            }
-            
-            // Check if it's a non-terminal (starts with '<')
-            if (oneTok[0] == '<') {
-                su->isNonTerminal = true;
-                su->value.nt = getNonTerminalFromString(oneTok);
-            } else {
-                // It's a terminal token (add "TK_" prefix for lookup)
-                char tmp[TOKEN_STR_LEN] = "TK_";
-                strcat(tmp, oneTok);
-                su->isNonTerminal = false;
-                su->value.t = getTokenFromString(tmp);
-            }
-            
-            // Create a node and add it to the RHS list
-            SymbolNode* rhsNode = createSymbolNode(su);
-            insertSymbolNode(gRule->rhs, rhsNode);
-            
-            // Get the next token
-            oneTok = strtok(NULL, " \t\n\r");
+        for (uint32_t i = loaded->ruleStart[r]; i < loaded->ruleStart[r + 1]; i++) {
+            SymbolCode code = loaded->symbols[i];
+            SymbolUnit* su = (SymbolUnit*)arenaAlloc(&grammarArena, sizeof(SymbolUnit));
+            symbolFromCode(su, IS_NT_CODE(code) ? NT_CODE(ntOf[CODE_TO_NT(code)]) : code);
+            insertSymbolNode(gRule->rhs, createSymbolNode(su));
         }
         
         // Add the rule to the grammar
-        Grammar[numOfRules++] = gRule;
+        Grammar[r] = gRule;
     }
-    
-    fclose(fp);
+    numOfRules = loaded->ruleCount;
+    grammarLoaded = true;
+    return true;
 }
 
 /**
@@ -492,24 +539,6 @@ void printGrammar() {
 
 /* ========================== FIRST & FOLLOW SET OPERATIONS ========================== */
 
-/**
- * Inserts a node into a FIRST or FOLLOW set list
- *
- * @param lst The FIRST or FOLLOW set list
- * @param nd The node to insert
- */
-void insertFirstFollowNode(FirstFollowSet* lst, FirstFollowNode* nd) {
-    if (!(lst->tail)) {
-        // List is empty
-        lst->head = nd;
-        lst->tail = nd;
-    } else {
-        // Add to the end
-        lst->tail->next = nd;
-        lst->tail = nd;
-    }
-}
-
 /**
  * Prints the computed FIRST and FOLLOW sets to separate files
  */
@@ -518,9 +547,9 @@ void printComputedFirstAndFollow() {
     FILE* foutFirst = fopen("computedfrst.txt", "w");
     for (int i = 0; i < NT_NOT_FOUND; i++) {
         fprintf(foutFirst, "%s:\t", nonTerminalToString[i]);
-        FirstFollowNode* tmp = AutoFirst[i]->head;
-        for (; tmp; tmp = tmp->next) {
-            fprintf(foutFirst, "%s\t", tokenToString[tmp->tk]);
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            if (IN_TOKEN_SET(AutoFirst[i], tk))
+                fprintf(foutFirst, "%s\t", tokenToString[tk]);
         }
         fprintf(foutFirst, "\n");
     }
@@ -530,9 +559,9 @@ void printComputedFirstAndFollow() {
     FILE* foutFollow = fopen("computedfllw.txt", "w");
     for (int i = 0; i < NT_NOT_FOUND; i++) {
         fprintf(foutFollow, "%s:\t", nonTerminalToString[i]);
-        FirstFollowNode* tmp = AutoFollow[i]->head;
-        for (; tmp; tmp = tmp->next) {
-            fprintf(foutFollow, "%s\t", tokenToString[tmp->tk]);
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            if (IN_TOKEN_SET(AutoFollow[i], tk))
+                fprintf(foutFollow, "%s\t", tokenToString[tk]);
         }
         fprintf(foutFollow, "\n");
     }
@@ -540,145 +569,166 @@ void printComputedFirstAndFollow() {
 }
 
 /**
- * Checks if a token exists in a given FIRST or FOLLOW set
+ * Computes the FIRST set of a sequence of grammar symbols (RHS of a rule)
  *
- * @param lst The FIRST or FOLLOW set to check
- * @param tmpkey The token to look for
- * @return true if the token exists in the set, false otherwise
+ * @param ritr The first symbol of the sequence, NULL for an empty sequence
+ * @return The FIRST set of the symbol sequence, with EPS if all of it can vanish
  */
-bool existsInFirstFollow(FirstFollowSet* lst, Token tmpkey) {
-    if (!lst) return false;
-    
-    // Iterate through the list to find the token
-    FirstFollowNode* current = lst->head;
-    for (; current; current = current->next) {
-        if (current->tk == tmpkey)
-            return true;
+TokenSet getFirstOfRhs(SymbolNode* ritr) {
+    TokenSet res = 0;
+    
+    // Process symbols until we find one that doesn't derive epsilon
+    for (; ritr; ritr = ritr->next) {
+        // A terminal is its own FIRST set and never derives epsilon
+        if (!(ritr->symbol->isNonTerminal))
+            return res | TOKEN_BIT(ritr->symbol->value.t);
+        
+        // For non-terminals, add all tokens from its FIRST set but epsilon
+        TokenSet ntFirst = AutoFirst[ritr->symbol->value.nt];
+        res |= ntFirst & ~TOKEN_BIT(EPS);
+        if (!IN_TOKEN_SET(ntFirst, EPS))
+            return res;
     }
     
-    return false;
+    // Every symbol derives epsilon, and so does the sequence
+    return res | TOKEN_BIT(EPS);
 }
 
 /**
- * Computes the FIRST set of a sequence of grammar symbols (RHS of a rule)
- *
- * @param grhs The symbol list (right-hand side of a rule)
- * @return The FIRST set of the symbol sequence
+ * Populates the parse table using the grammar rules and FIRST/FOLLOW sets
  */
-FirstFollowSet* getFirstOfRhs(SymbolList* grhs) {
-    // Create a new set for the result
-    FirstFollowSet* res = (FirstFollowSet*)malloc(sizeof(FirstFollowSet));
-    res->head = NULL;
-    res->tail = NULL;
-    
-    // Start with the first symbol in the sequence
-    SymbolNode* ritr = grhs->head;
-    bool hasEps = true;  // Assume epsilon derivability initially
-    
-    // Process symbols until we find one that doesn't derive epsilon
-    for (; ritr && hasEps; ritr = ritr->next) {
-        FirstFollowNode* tmp;
-        hasEps = false;  // Reset for this iteration
+void addRulesToParseTable() {
+    // For each grammar rule
+    for (int gri = 0; gri < numOfRules; ++gri) {
+        GrammarRule* tmpRule = Grammar[gri];
         
-        // If it's a terminal, add it to FIRST and we're done
-        if (!(ritr->symbol->isNonTerminal)) {
-            if (!existsInFirstFollow(res, ritr->symbol->value.t)) {
-                FirstFollowNode* vtmp = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                vtmp->next = NULL;
-                vtmp->tk = ritr->symbol->value.t;
-                insertFirstFollowNode(res, vtmp);
-            }
-            break;  // Terminals don't derive epsilon, so stop here
-        }
+        // The rule is chosen on FIRST(RHS), and on FOLLOW(LHS) when the RHS can vanish
+        TokenSet fOfRhs = getFirstOfRhs(tmpRule->rhs->head);
+        TokenSet predict = fOfRhs & ~TOKEN_BIT(EPS);
+        if (IN_TOKEN_SET(fOfRhs, EPS))
+            predict |= AutoFollow[tmpRule->lhs->value.nt];
         
-        // For non-terminals, add all tokens from its FIRST set
-        for (tmp = AutoFirst[ritr->symbol->value.nt]->head; tmp; tmp = tmp->next) {
-            if (tmp->tk == EPS) {
-                hasEps = true;  // This non-terminal can derive epsilon
-                continue;        // Don't add epsilon yet
-            }
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            if (!IN_TOKEN_SET(predict, tk))
+                continue;
             
-            // Add the token if it's not already in the result
-            if (!existsInFirstFollow(res, tmp->tk)) {
-                FirstFollowNode* cpytmp = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                cpytmp->next = NULL;
-                cpytmp->tk = tmp->tk;
-                insertFirstFollowNode(res, cpytmp);
-            }
+            // Check for conflicts (multiple rules for same cell)
+            if (parseTable[tmpRule->lhs->value.nt][tk] != NULL)
+                fprintf(stderr, "\nMultiple defined entries in parse table detected! (Overwriting the rule!)\n");
+            
+            // Add the rule to the parse table and its dense form
+            parseTable[tmpRule->lhs->value.nt][tk] = tmpRule;
+            RULE_TABLE_CELL(tmpRule->lhs->value.nt, tk) = (RuleIndex)(gri + 1);
         }
     }
+}
+
+/**
+ * Builds the compiled form of every grammar rule in the grammar arena
+ */
+void compileRules() {
+    // The forward and reversed sequences of each rule sit side by side
+    int total = 0;
+    for (int gri = 0; gri < numOfRules; ++gri)
+        total += Grammar[gri]->rhs->count;
+    SymbolCode* codes = (SymbolCode*)arenaAlloc(&grammarArena, (2 * total + 1) * sizeof(SymbolCode));
+    compiledRules = (CompiledRule*)arenaAlloc(&grammarArena, (numOfRules + 1) * sizeof(CompiledRule));
     
-    // If we went through all symbols and they all derive epsilon,
-    // then add epsilon to the result
-    if (ritr == NULL && hasEps) {
-        FirstFollowNode* vvtmp = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-        vvtmp->next = NULL;
-        vvtmp->tk = EPS;
-        if (!existsInFirstFollow(res, EPS)) 
-            insertFirstFollowNode(res, vvtmp);
+    for (int gri = 0; gri < numOfRules; ++gri) {
+        CompiledRule* cr = &compiledRules[gri];
+        int length = Grammar[gri]->rhs->count;
+        cr->lhs = Grammar[gri]->lhs->value.nt;
+        cr->length = length;
+        cr->rhs = codes;
+        cr->push = codes + length;
+        int i = 0;
+        for (SymbolNode* rhsItr = Grammar[gri]->rhs->head; rhsItr; rhsItr = rhsItr->next, i++) {
+            codes[i] = symbolCodeOf(rhsItr->symbol);
+            codes[2 * length - 1 - i] = codes[i];
+        }
+        codes += 2 * length;
     }
-    
-    return res;
 }
 
 /**
- * Frees the memory allocated for a FIRST or FOLLOW set
+ * Checks whether a rule is a unit production, with a single non-terminal as its RHS
  *
- * @param rl The set to free
+ * @param rule Index of the rule, NO_RULE for none
+ * @return true for a unit production
  */
-void freeUpFirstFollow(FirstFollowSet* rl) {
-    if (!rl) return;
-    
-    // Free each node in the list
-    FirstFollowNode *tmp, *tn;
-    tmp = rl->head;
-    while (tmp) {
-        tn = tmp;
-        tmp = tmp->next;
-        free(tn);
+static bool isUnitRule(RuleIndex rule) {
+    return rule != NO_RULE && compiledRules[rule - 1].length == 1 && IS_NT_CODE(compiledRules[rule - 1].rhs[0]);
+}
+
+/**
+ * Follows the unit productions from a parse table cell, optionally recording them
+ *
+ * @param nt The non-terminal of the cell
+ * @param tk The token of the cell
+ * @param out Where to store the rules applied, or NULL to only count them
+ * @return The number of rules applied on the token, the first one included
+ */
+static int walkUnitChain(NonTerminal nt, Token tk, RuleIndex* out) {
+    int links = 0;
+    RuleIndex rule = RULE_TABLE_CELL(nt, tk);
+    
+    // Each link looks up the token again for the single RHS non-terminal;
+    // the bound only matters for grammars that are not LL(1)
+    while (rule != NO_RULE && links <= NT_NOT_FOUND) {
+        if (out)
+            out[links] = rule;
+        links++;
+        if (!isUnitRule(rule))
+            break;
+        rule = RULE_TABLE_CELL(CODE_TO_NT(compiledRules[rule - 1].rhs[0]), tk);
     }
+    return links;
 }
 
 /**
- * Populates the parse table using the grammar rules and FIRST/FOLLOW sets
+ * Records the unit production chain of every parse table cell whose rule is
+ * a unit production followed by at least one more rule on the same token
  */
-void addRulesToParseTable() {
-    // For each grammar rule
-    for (int gri = 0; gri < numOfRules; ++gri) {
-        GrammarRule* tmpRule = Grammar[gri];
-        
-        // Get the FIRST set of the RHS
-        FirstFollowSet* fOfRhs = getFirstOfRhs(tmpRule->rhs);
-        FirstFollowNode* tItr;
-        
-        // For each terminal in FIRST(RHS), add the rule to the parse table
-        for (tItr = fOfRhs->head; tItr; tItr = tItr->next) {
-            // Check for conflicts (multiple rules for same cell)
-            if (parseTable[tmpRule->lhs->value.nt][tItr->tk] != NULL)
-                fprintf(stderr, "\nMultiple defined entries in parse table detected! (Overwriting the rule!)\n");
-            
-            // Add the rule to the parse table
-            parseTable[tmpRule->lhs->value.nt][tItr->tk] = tmpRule;
+void buildUnitChains() {
+    unitChainStart = (uint32_t*)arenaCalloc(&grammarArena, NT_NOT_FOUND * TK_NOT_FOUND * sizeof(uint32_t));
+    
+    // Size the chains first, then lay them out
+    uint32_t total = 1;
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            int links = isUnitRule(RULE_TABLE_CELL(nt, tk)) ? walkUnitChain((NonTerminal)nt, (Token)tk, NULL) : 0;
+            if (links > 1)
+                total += 1 + links;
         }
-        
-        // If epsilon is in FIRST(RHS), add the rule for each token in FOLLOW(LHS)
-        if (existsInFirstFollow(fOfRhs, EPS)) {
-            FirstFollowNode* antItr;
-            for (antItr = AutoFollow[tmpRule->lhs->value.nt]->head; antItr; antItr = antItr->next) {
-                // Check for conflicts
-                if (parseTable[tmpRule->lhs->value.nt][antItr->tk] != NULL)
-                    fprintf(stderr, "\nMultiple defined entries in parse table detected! (Overwriting the rule!)\n");
-                
-                // Add the rule to the parse table
-                parseTable[tmpRule->lhs->value.nt][antItr->tk] = tmpRule;
-            }
+    }
+    unitChainRules = (RuleIndex*)arenaCalloc(&grammarArena, total * sizeof(RuleIndex));
+    
+    uint32_t next = 1;
+    for (int nt = 0; nt < NT_NOT_FOUND; nt++) {
+        for (int tk = 0; tk < TK_NOT_FOUND; tk++) {
+            if (!isUnitRule(RULE_TABLE_CELL(nt, tk)))
+                continue;
+            int links = walkUnitChain((NonTerminal)nt, (Token)tk, &unitChainRules[next + 1]);
+            if (links < 2)
+                continue;
+            UNIT_CHAIN_CELL(nt, tk) = next;
+            unitChainRules[next] = (RuleIndex)links;
+            next += 1 + links;
         }
-        
-        // Free the temporary FIRST set
-        freeUpFirstFollow(fOfRhs);
     }
 }
 
+/**
+ * Allocates an empty dense parse table in the grammar arena
+ *
+ * @return The table, aligned to a cache line, with every cell NO_RULE
+ */
+RuleIndex* newRuleTable() {
+    size_t bytes = NT_NOT_FOUND * TK_NOT_FOUND * sizeof(RuleIndex);
+    char* block = (char*)arenaCalloc(&grammarArena, bytes + PARSE_TABLE_ALIGN - 1);
+    return (RuleIndex*)(((uintptr_t)block + PARSE_TABLE_ALIGN - 1) & ~(uintptr_t)(PARSE_TABLE_ALIGN - 1));
+}
+
 /**
  * Creates and initializes the parse table structure
  */
@@ -688,28 +738,18 @@ void initializeParseTable() {
     parseTreeInitialized = true;
     
     // Allocate memory for the parse table (NT_NOT_FOUND × TK_NOT_FOUND matrix)
-    parseTable = (GrammarRule***)malloc(NT_NOT_FOUND * sizeof(GrammarRule**));
-    if (!parseTable) {
-        fprintf(stderr, "Couldn't allocate memory for parseTable rows\n");
-        return;
-    }
+    parseTable = (GrammarRule***)arenaAlloc(&grammarArena, NT_NOT_FOUND * sizeof(GrammarRule**));
     
-    // Allocate memory for each row and initialize to NULL
+    // Allocate memory for each row, with all entries NULL (no rule)
     for (int nti = 0; nti < NT_NOT_FOUND; nti++) {
-        parseTable[nti] = (GrammarRule**)malloc(TK_NOT_FOUND * sizeof(GrammarRule*));
-        if (!parseTable[nti]) {
-            fprintf(stderr, "Couldn't allocate memory for parseTable columns\n");
-            return;
-        }
-        
-        // Initialize all entries to NULL (no rule)
-        for (int tki = 0; tki < TK_NOT_FOUND; tki++) {
-            parseTable[nti][tki] = NULL;
-        }
+        parseTable[nti] = (GrammarRule**)arenaCalloc(&grammarArena, TK_NOT_FOUND * sizeof(GrammarRule*));
     }
+    ruleTable = newRuleTable();
     
     // Populate the parse table with rules
     addRulesToParseTable();
+    compileRules();
+    buildUnitChains();
 }
 
 /**
@@ -765,62 +805,66 @@ void printParseTable() {
 /**
  * Prints information about a parse tree node in a formatted manner
  *
+ * @param tree The tree the nodes belong to
  * @param curr The current node to print
- * @param par The parent of the current node
+ * @param par The parent of the current node, NULL for the root
  * @param fp The file to print to
  */
-void printTreeNode(ParseNode* curr, ParseNode* par, FILE* fp) {
+void printTreeNode(const ParseTree* tree, const ParseNode* curr, const ParseNode* par, FILE* fp) {
+    bool isNonTerminal = IS_NT_CODE(curr->code);
+    SymbolTableEntry* ste = parseNodeEntry(tree, curr);
+    
     // Print lexeme (or ----- for non-terminals)
-    fprintf(fp, "%*s ", 32, !(curr->symbol->isNonTerminal) ? curr->ste->lexeme : "-----");
+    fprintf(fp, "%*s ", 32, !isNonTerminal ? ste->lexeme : "-----");
     
-    // Print line number
-    fprintf(fp, "%*d ", 12, curr->lineNumber);
+    // Print line number (-1 for nodes the parser never reached)
+    fprintf(fp, "%*d ", 12, curr->lineNumber ? (int)curr->lineNumber : -1);
     
     // Print token name (or ----- for non-terminals)
-    fprintf(fp, "%*s ", 16, curr->symbol->isNonTerminal ? "-----" : tokenToString[curr->ste->tokenType]);
+    fprintf(fp, "%*s ", 16, isNonTerminal ? "-----" : tokenToString[ste->tokenType]);
     
     // Print numeric value for numbers, or "Not number" otherwise
-    if (!(curr->symbol->isNonTerminal) && (curr->ste->tokenType == NUM || curr->ste->tokenType == RNUM)) {
-        if (curr->ste->tokenType == NUM)
-            fprintf(fp, "%*d ", 20, (int)(curr->ste->numericValue));
+    if (!isNonTerminal && (ste->tokenType == NUM || ste->tokenType == RNUM)) {
+        if (ste->tokenType == NUM)
+            fprintf(fp, "%*d ", 20, (int)getNumericValue(ste));
         else    
-            fprintf(fp, "%20.2lf ", curr->ste->numericValue);
+            fprintf(fp, "%20.2lf ", getNumericValue(ste));
     } else {
         fprintf(fp, "%*s ", 20, "Not number ");
     }
     
     // Print parent node symbol
-    fprintf(fp, "%*s ", 30, par ? nonTerminalToString[par->symbol->value.nt] : "ROOT");
+    fprintf(fp, "%*s ", 30, par ? nonTerminalToString[CODE_TO_NT(par->code)] : "ROOT");
     
     // Print whether it's a leaf node
-    fprintf(fp, "%*s ", 12, curr->symbol->isNonTerminal ? "NO" : "YES");
+    fprintf(fp, "%*s ", 12, isNonTerminal ? "NO" : "YES");
     
     // Print node symbol
-    fprintf(fp, "%*s ", 30, curr->symbol->isNonTerminal ? nonTerminalToString[curr->symbol->value.nt] : "-----");
+    fprintf(fp, "%*s ", 30, isNonTerminal ? nonTerminalToString[CODE_TO_NT(curr->code)] : "-----");
     fprintf(fp, "\n");
 }
 
 /**
  * Performs an inorder traversal of the parse tree and prints each node
  *
- * @param curr The current node to traverse
- * @param par The parent of the current node
+ * @param tree The tree to traverse
+ * @param curr Index of the current node
+ * @param par The parent of the current node, NULL for the root
  * @param fp The file to print to
  */
-void inorderTraverse(ParseNode* curr, ParseNode* par, FILE* fp) {
-    if (!curr)
-        return;
+void inorderTraverse(const ParseTree* tree, uint32_t curr, const ParseNode* par, FILE* fp) {
+    const ParseNode* node = &tree->nodes[curr];
     
     // Traverse left subtree
-    if (curr->size)
-        inorderTraverse(curr->children[0], curr, fp);
+    if (node->childCount)
+        inorderTraverse(tree, node->firstChild, node, fp);
     
     // Print current node
-    printTreeNode(curr, par, fp);
+    printTreeNode(tree, node, par, fp);
     
     // Traverse right subtree
-    for (int chi = 1; chi < curr->size; ++chi)
-        inorderTraverse(curr->children[chi], curr, fp);
+    for (uint32_t chi = 1; chi < node->childCount; ++chi)
+        inorderTraverse(tree, node->firstChild + chi, node, fp);
 }
 
 /**
@@ -848,7 +892,7 @@ void printParseTree(ParseTree* PT, char* outFile) {
     fprintf(fp, "%*s %*s %*s %*s %*s %*s %*s\n\n", 32, "lexeme", 12, "lineNum", 16, "tokenName", 20, "valueIfNumber", 30, "parentNodeSymbol", 12, "isLeafNode", 30, "nodeSymbol");
     
     // Traverse and print the tree
-    inorderTraverse(PT->root, NULL, fp);
+    inorderTraverse(PT, PARSE_TREE_ROOT, NULL, fp);
     
     fclose(fp);
     
@@ -859,159 +903,175 @@ void printParseTree(ParseTree* PT, char* outFile) {
 /* ========================== PARSING FUNCTIONS ========================== */
 
 /**
- * Parses the token list using the parse table and builds the corresponding parse tree
- * Reports syntax errors if any
+ * Prints where a syntax error was found: "path:line:column" when the token
+ * has a span in a registered file, else its line number alone (token
+ * streams and packed streams keep no spans)
+ *
+ * @param loc Span of the token the error is reported at
+ * @param line Line number of that token
+ */
+static void printErrorLocation(SourceLoc loc, int line) {
+    if (resolveSourceLoc(loc, NULL, NULL))
+        printSourceLoc(stdout, loc);
+    else
+        printf("Line %*d", 5, line);
+}
+
+/**
+ * Parses the tokens read through a cursor using the parse table and builds the
+ * corresponding parse tree. Reports syntax errors if any
  *
- * @param tokensFromLexer The list of tokens from the lexer
+ * @param tables The frozen tables to parse with
+ * @param input Cursor over the tokens from the lexer
+ * @param options Settings of this parse, NULL for the defaults
  * @param hasSyntaxError Pointer to a boolean flag indicating if syntax errors were found
  * @return The constructed parse tree, or NULL if parsing failed
  */
-ParseTree* parseTokens(TokenList* tokensFromLexer, bool* hasSyntaxError) {
-    if (!tokensFromLexer) {
-        fprintf(stderr, "Tokens list from lexer is NULL. Parsing failed\n");
+ParseTree* parseTokens(const ParserTables* tables, TokenCursor* input, const ParseOptions* options, bool* hasSyntaxError) {
+    if (!input) {
+        fprintf(stderr, "Token cursor from lexer is NULL. Parsing failed\n");
         return NULL;
     }
     
-    // Initialize input pointer and parse tree
-    TokenNode* inputPtr = tokensFromLexer->head;
-    ParseTree* theParseTree = createParseTree();
-    ParseNode* currentNode = theParseTree->root;
-    
-    // Create and set up the root symbol
-    SymbolUnit* su = (SymbolUnit*)malloc(sizeof(SymbolUnit));
-    su->isNonTerminal = true;
-    su->value.nt = program;
-    currentNode->symbol = su;
+    // Initialize parse tree
+    ParseTree* theParseTree = createParseTree(input->symbols);
+    if (!theParseTree)
+        return NULL;
+    if (options)
+        theParseTree->elideEpsilonLeaves = options->elideEpsilonLeaves;
+    ParseNode* currentNode;
+    uint32_t current = PARSE_TREE_ROOT;
     
     // Initialize stack and push the root node
     Stack* theStack = initializeStack();
-    pushStack(theStack, currentNode);
+    pushStack(theStack, current);
     
     int cln = 1;  // Current line number
+    SourceLoc lastLoc = NO_SOURCE_LOC;  // Span of the last token read
     
     if (debugPrint)
         printf("Parsing starting...\n"), fflush(stdout);
     
     // Main parsing loop
-    while (!isStackEmpty(theStack) && inputPtr) {
-        cln = inputPtr->lineNum;
-        currentNode = peekStack(theStack);
+    while (!isStackEmpty(theStack) && !input->atEnd) {
+        Token inputTk = input->kind;
+        int inputLine = (int)input->lineNum;
+        cln = inputLine;
+        lastLoc = input->loc;
+        current = peekStack(theStack);
+        currentNode = &theParseTree->nodes[current];
         
         // Skip comments and lexical errors
-        if (inputPtr->entry->tokenType == COMMENT || inputPtr->entry->tokenType >= LEXICAL_ERROR) {
-            if (inputPtr->entry->tokenType == LEXICAL_ERROR) {
+        if (inputTk == COMMENT || inputTk >= LEXICAL_ERROR) {
+            if (inputTk == LEXICAL_ERROR) {
                 if (debugPrint)
-                    printf("Line %*d \tError: Unrecognized pattern: \"%s\"\n", 5, inputPtr->lineNum, inputPtr->entry->lexeme);
+                    printErrorLocation(input->loc, inputLine), printf(" \tError: Unrecognized pattern: \"%s\"\n", cursorEntry(input)->lexeme);
             }
-            else if (inputPtr->entry->tokenType == ID_LENGTH_EXC) {
+            else if (inputTk == ID_LENGTH_EXC) {
                 if (debugPrint)
-                    printf("Line %*d \tError: Too long identifier: \"%s\"\n", 5, inputPtr->lineNum, inputPtr->entry->lexeme);
+                    printErrorLocation(input->loc, inputLine), printf(" \tError: Too long identifier: \"%s\"\n", cursorEntry(input)->lexeme);
             }
-            else if (inputPtr->entry->tokenType == FUN_LENGTH_EXC) {
+            else if (inputTk == FUN_LENGTH_EXC) {
                 if (debugPrint)
-                    printf("Line %*d \tError: Too long function name: \"%s\"\n", 5, inputPtr->lineNum, inputPtr->entry->lexeme);
+                    printErrorLocation(input->loc, inputLine), printf(" \tError: Too long function name: \"%s\"\n", cursorEntry(input)->lexeme);
             }
-            if (inputPtr->entry->tokenType != COMMENT)
+            if (inputTk != COMMENT)
                 *hasSyntaxError = true;
-            inputPtr = inputPtr->next;
+            advanceCursor(input);
             continue;
         }
         
+        // Rule to expand a non-terminal with
+        bool isNonTerminal = IS_NT_CODE(currentNode->code);
+        RuleIndex expansion = isNonTerminal
+            ? PARSE_TABLE_LOOKUP(tables, CODE_TO_NT(currentNode->code), inputTk) : NO_RULE;
+        
         // Handle epsilon transitions
-        if (!(currentNode->symbol->isNonTerminal) && currentNode->symbol->value.t == EPS) {
-            currentNode->lineNumber = inputPtr->lineNum;
-            SymbolTableEntry* tste = (SymbolTableEntry*)malloc(sizeof(SymbolTableEntry));
-            strcpy(tste->lexeme, "EPSILON");
-            tste->numericValue = 0;
-            currentNode->ste = tste;
-            tste->tokenType = EPS;
+        if (currentNode->code == EPS) {
+            currentNode->lineNumber = (uint32_t)inputLine;
             popStack(theStack);
             continue;
         }
         
         // Handle terminal matches
-        if (!(currentNode->symbol->isNonTerminal) && currentNode->symbol->value.t == inputPtr->entry->tokenType) {
-            currentNode->lineNumber = inputPtr->lineNum;
-            currentNode->ste = inputPtr->entry;
+        if (!isNonTerminal && currentNode->code == inputTk) {
+            currentNode->lineNumber = (uint32_t)inputLine;
+            currentNode->symbolId = input->symbolId;
             popStack(theStack);
-            inputPtr = inputPtr->next;
+            advanceCursor(input);
         }
         // Handle terminal mismatches
-        else if (!(currentNode->symbol->isNonTerminal)) {
+        else if (!isNonTerminal) {
             *hasSyntaxError = true;
             if (debugPrint)
-                printf("Line %*d \tError: The token %s for lexeme \"%s\" does not match the expected token %s\n", 
-                    5, inputPtr->lineNum, tokenToString[inputPtr->entry->tokenType], 
-                    inputPtr->entry->lexeme, tokenToString[currentNode->symbol->value.t]);
-            currentNode->lineNumber = inputPtr->lineNum;
+                printErrorLocation(input->loc, inputLine), printf(" \tError: The token %s for lexeme \"%s\" does not match the expected token %s\n", 
+                    tokenToString[inputTk], cursorEntry(input)->lexeme, tokenToString[currentNode->code]);
+            currentNode->lineNumber = (uint32_t)inputLine;
             popStack(theStack);
         }
         // Handle non-terminal mismatches
-        else if (parseTable[currentNode->symbol->value.nt][inputPtr->entry->tokenType] == NULL) {
+        else if (expansion == NO_RULE) {
             *hasSyntaxError = true;
             if (debugPrint)
-                printf("Line %*d \tError: Invalid token %s encountered with value \"%s\". Stack top is: %s\n", 
-                    5, inputPtr->lineNum, tokenToString[inputPtr->entry->tokenType], 
-                    inputPtr->entry->lexeme, nonTerminalToString[currentNode->symbol->value.nt]);
-            if (existsInFirstFollow(AutoFollow[currentNode->symbol->value.nt], inputPtr->entry->tokenType)) {
-                currentNode->lineNumber = inputPtr->lineNum;
+                printErrorLocation(input->loc, inputLine), printf(" \tError: Invalid token %s encountered with value \"%s\". Stack top is: %s\n", 
+                    tokenToString[inputTk], cursorEntry(input)->lexeme, nonTerminalToString[CODE_TO_NT(currentNode->code)]);
+            if (IN_TOKEN_SET(tables->follow[CODE_TO_NT(currentNode->code)], inputTk)) {
+                currentNode->lineNumber = (uint32_t)inputLine;
                 popStack(theStack);
             } else {
-                inputPtr = inputPtr->next;
-                if (!inputPtr) {
+                advanceCursor(input);
+                if (input->atEnd)
                     popStack(theStack);
-                    currentNode = peekStack(theStack);
-                }
             }
         }
         // Handle valid non-terminal transitions
         else {
-            GrammarRule* tmpRule = parseTable[currentNode->symbol->value.nt][inputPtr->entry->tokenType];
             popStack(theStack);
-            currentNode->lineNumber = inputPtr->lineNum;
-            SymbolNode* trItr = tmpRule->rhs->head;
-            ParseNode* pn;
-            while (trItr) {
-                pn = createParseNode();
-                pn->symbol = (SymbolUnit*)malloc(sizeof(SymbolUnit));
-                pn->symbol->isNonTerminal = trItr->symbol->isNonTerminal;
-                if (pn->symbol->isNonTerminal)
-                    pn->symbol->value.nt = trItr->symbol->value.nt;
-                else 
-                    pn->symbol->value.t = trItr->symbol->value.t;
-                insertChild(currentNode, pn);
-                trItr = trItr->next;
+            currentNode->lineNumber = (uint32_t)inputLine;
+            
+            // Apply a unit chain in one step: each unit production adds the
+            // node the parser would have pushed and popped right away
+            uint32_t chain = tables->unitChainStart[CODE_TO_NT(currentNode->code) * TK_NOT_FOUND + inputTk];
+            if (chain) {
+                int links = tables->unitChainRules[chain];
+                for (int k = 1; k < links && current != NO_PARSE_NODE; k++) {
+                    const CompiledRule* unit = &tables->rules[tables->unitChainRules[chain + k] - 1];
+                    current = addChildren(theParseTree, current, 1);
+                    if (current != NO_PARSE_NODE)
+                        theParseTree->nodes[current] = (ParseNode){ unit->rhs[0], 0, NO_PARSE_NODE, NO_SYMBOL_ID, (uint32_t)inputLine };
+                }
+                expansion = tables->unitChainRules[chain + links];
             }
-            for (int chi = currentNode->size - 1; chi >= 0; chi--) {
-                pushStack(theStack, currentNode->children[chi]);
+            if (current == NO_PARSE_NODE || !expandRule(theParseTree, theStack, current, &tables->rules[expansion - 1])) {
+                *hasSyntaxError = true;
+                break;
             }
         }
     }
     
     // Check for successful parsing
-    if (!(*hasSyntaxError) && isStackEmpty(theStack) && (!inputPtr || inputPtr->entry->tokenType == DOLLAR)) {
+    if (!(*hasSyntaxError) && isStackEmpty(theStack) && (input->atEnd || input->kind == DOLLAR)) {
         if (debugPrint)
             printf("\nParsing successful! No syntax errors! The input is syntactically correct!\n");
     } else {
         *hasSyntaxError = true;
         while (!isStackEmpty(theStack)) {
-            currentNode = peekStack(theStack);
-            if (currentNode->symbol->isNonTerminal) {
+            currentNode = &theParseTree->nodes[peekStack(theStack)];
+            if (IS_NT_CODE(currentNode->code)) {
                 if (debugPrint)
-                    printf("Line %*d \tError: Invalid token TK_DOLLAR encountered. Stack top is: %s\n", 
-                        5, cln, nonTerminalToString[currentNode->symbol->value.nt]);
+                    printErrorLocation(lastLoc, cln), printf(" \tError: Invalid token TK_DOLLAR encountered. Stack top is: %s\n", 
+                        nonTerminalToString[CODE_TO_NT(currentNode->code)]);
             } else {
                 if (debugPrint)
-                    printf("Line %*d \tError: The token TK_DOLLAR for lexeme \"\" does not match the expected token %s\n", 
-                        5, cln, tokenToString[currentNode->symbol->value.t]);
+                    printErrorLocation(lastLoc, cln), printf(" \tError: The token TK_DOLLAR for lexeme \"\" does not match the expected token %s\n", 
+                        tokenToString[currentNode->code]);
             }
             popStack(theStack);
         }
-        while (inputPtr && inputPtr->entry->tokenType != DOLLAR) {
+        for (; !input->atEnd && input->kind != DOLLAR; advanceCursor(input)) {
             if (debugPrint)
-                printf("Line %*d \tError: Invalid token %s encountered with value \"%s\". Stack top is: TK_DOLLAR\n", 
-                    5, inputPtr->lineNum, tokenToString[inputPtr->entry->tokenType], inputPtr->entry->lexeme);
-            inputPtr = inputPtr->next;
+                printErrorLocation(input->loc, (int)input->lineNum), printf(" \tError: Invalid token %s encountered with value \"%s\". Stack top is: TK_DOLLAR\n", 
+                    tokenToString[input->kind], cursorEntry(input)->lexeme);
         }
         if (debugPrint)
             printf("\nThe input file has syntactic errors!\n");
@@ -1020,143 +1080,6 @@ ParseTree* parseTokens(TokenList* tokensFromLexer, bool* hasSyntaxError) {
     return theParseTree;
 }
 
-/**
- * Computes the FIRST sets for all non-terminals
- */
-void computeFirstSets() {
-    bool modified = true;
-    
-    // Iterate until no more changes are made
-    while (modified) {
-        modified = false;
-        
-        // For each grammar rule
-        for (int gri = 0; gri < numOfRules; ++gri) {
-            NonTerminal currLhs = Grammar[gri]->lhs->value.nt;
-            SymbolNode* rhsItr = Grammar[gri]->rhs->head;
-            bool hasEps = true;
-            
-            // Process symbols on the RHS
-            while (rhsItr && hasEps) {
-                hasEps = false;
-                
-                // If it's a terminal, add it to FIRST and we're done
-                if (!(rhsItr->symbol->isNonTerminal)) {
-                    if (!existsInFirstFollow(AutoFirst[currLhs], rhsItr->symbol->value.t)) {
-                        FirstFollowNode* vtmp = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                        vtmp->next = NULL;
-                        vtmp->tk = rhsItr->symbol->value.t;
-                        insertFirstFollowNode(AutoFirst[currLhs], vtmp);
-                        modified = true;
-                    }
-                    break;
-                }
-                
-                // For non-terminals, add all tokens from its FIRST set
-                FirstFollowNode* feaItr;
-                for (feaItr = AutoFirst[rhsItr->symbol->value.nt]->head; feaItr; feaItr = feaItr->next) {
-                    if (feaItr->tk == EPS) {
-                        hasEps = true;
-                        continue;
-                    }
-                    if (!existsInFirstFollow(AutoFirst[currLhs], feaItr->tk)) {
-                        FirstFollowNode* cpytmp = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                        cpytmp->next = NULL;
-                        cpytmp->tk = feaItr->tk;
-                        insertFirstFollowNode(AutoFirst[currLhs], cpytmp);
-                        modified = true;
-                    }
-                }
-                rhsItr = rhsItr->next;
-            }
-            
-            // If all symbols derive epsilon, add epsilon to FIRST
-            if (!rhsItr && hasEps) {
-                if (!existsInFirstFollow(AutoFirst[currLhs], EPS)) {
-                    FirstFollowNode* vvtmp = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                    vvtmp->next = NULL;
-                    vvtmp->tk = EPS;
-                    insertFirstFollowNode(AutoFirst[currLhs], vvtmp);
-                    modified = true;
-                }
-            }
-        }
-    }
-}
-
-/**
- * Computes the FOLLOW sets for all non-terminals
- */
-void computeFollowSets() {
-    // Add $ to FOLLOW(program)
-    FirstFollowNode* thdl = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-    thdl->next = NULL;
-    thdl->tk = DOLLAR;
-    insertFirstFollowNode(AutoFollow[program], thdl);
-
-    bool modified = true;
-    
-    // Iterate until no more changes are made
-    while (modified) {
-        modified = false;
-        
-        // For each grammar rule
-        for (int gri = 0; gri < numOfRules; ++gri) {
-            NonTerminal currLhs = Grammar[gri]->lhs->value.nt;
-            SymbolNode* rhsItr = Grammar[gri]->rhs->head;
-            
-            // Process symbols on the RHS
-            while (rhsItr) {
-                if (!(rhsItr->symbol->isNonTerminal)) {
-                    rhsItr = rhsItr->next;
-                    continue;
-                }
-                
-                // Create a temporary symbol list starting from the next node
-                SymbolList* tgl = (SymbolList*)malloc(sizeof(SymbolList));
-                tgl->head = rhsItr->next;
-                tgl->tail = NULL;
-                tgl->count = 0;
-                
-                // Get FIRST of the remaining symbols
-                FirstFollowSet* fOfNxtT = getFirstOfRhs(tgl);
-                FirstFollowNode* felItr;
-                
-                // Add tokens from FIRST to FOLLOW
-                for (felItr = fOfNxtT->head; felItr; felItr = felItr->next) {
-                    if (felItr->tk == EPS) continue;
-                    if (!existsInFirstFollow(AutoFollow[rhsItr->symbol->value.nt], felItr->tk)) {
-                        FirstFollowNode* vvvt = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                        vvvt->next = NULL;
-                        vvvt->tk = felItr->tk;
-                        insertFirstFollowNode(AutoFollow[rhsItr->symbol->value.nt], vvvt);
-                        modified = true;
-                    }
-                }
-                
-                // If epsilon is in FIRST, add FOLLOW(LHS) to FOLLOW(current)
-                if (existsInFirstFollow(fOfNxtT, EPS) || !(rhsItr->next)) {
-                    FirstFollowNode* flwItr;
-                    for (flwItr = AutoFollow[currLhs]->head; flwItr; flwItr = flwItr->next) {
-                        if (!existsInFirstFollow(AutoFollow[rhsItr->symbol->value.nt], flwItr->tk)) {
-                            FirstFollowNode* avt = (FirstFollowNode*)malloc(sizeof(FirstFollowNode));
-                            avt->next = NULL;
-                            avt->tk = flwItr->tk;
-                            insertFirstFollowNode(AutoFollow[rhsItr->symbol->value.nt], avt);
-                            modified = true;
-                        }
-                    }
-                }
-                
-                // Free temporary FIRST set
-                freeUpFirstFollow(fOfNxtT);
-                free(tgl);
-                rhsItr = rhsItr->next;
-            }
-        }
-    }
-}
-
 /**
  * Allocates data structures for FIRST and FOLLOW sets and computes them
  */
@@ -1167,68 +1090,96 @@ void initializeAndComputeFirstAndFollow() {
         
     firstFollowComputed = true;
     
-    // Allocate memory for FIRST and FOLLOW sets
-    AutoFirst = (FirstFollowSet**)malloc(NT_NOT_FOUND * sizeof(FirstFollowSet*));
-    AutoFollow = (FirstFollowSet**)malloc(NT_NOT_FOUND * sizeof(FirstFollowSet*));
-    if (!AutoFirst || !AutoFollow) {
-        fprintf(stderr, "Could not allocate memory for auto FIRST and FOLLOW sets array\n");
-        return;
-    }
+    // Allocate FIRST and FOLLOW sets
+    AutoFirst = (TokenSet*)arenaCalloc(&grammarArena, NT_NOT_FOUND * sizeof(TokenSet));
+    AutoFollow = (TokenSet*)arenaCalloc(&grammarArena, NT_NOT_FOUND * sizeof(TokenSet));
     
-    // Initialize each set
-    for (int i = 0; i < NT_NOT_FOUND; i++) {
-        AutoFirst[i] = (FirstFollowSet*)malloc(sizeof(FirstFollowSet));
-        if (!(AutoFirst[i])) {
-            fprintf(stderr, "Could not allocate memory for auto FIRST sets\n");
-            return;
-        }
-        AutoFirst[i]->head = NULL;
-        AutoFirst[i]->tail = NULL;
-        
-        AutoFollow[i] = (FirstFollowSet*)malloc(sizeof(FirstFollowSet));
-        if (!(AutoFollow[i])) {
-            fprintf(stderr, "Could not allocate memory for auto FOLLOW sets\n");
-            return;
-        }
-        AutoFollow[i]->head = NULL;
-        AutoFollow[i]->tail = NULL;
+    // Lay the grammar out as symbol codes for the solver
+    uint32_t* ruleStart = (uint32_t*)arenaAlloc(&grammarArena, (numOfRules + 1) * sizeof(uint32_t));
+    SymbolCode* ruleLhs = (SymbolCode*)arenaAlloc(&grammarArena, (numOfRules + 1) * sizeof(SymbolCode));
+    uint32_t symbolCount = 0;
+    for (int gri = 0; gri < numOfRules; ++gri)
+        symbolCount += Grammar[gri]->rhs->count;
+    SymbolCode* symbols = (SymbolCode*)arenaAlloc(&grammarArena, (symbolCount + 1) * sizeof(SymbolCode));
+    
+    symbolCount = 0;
+    for (int gri = 0; gri < numOfRules; ++gri) {
+        ruleStart[gri] = symbolCount;
+        ruleLhs[gri] = symbolCodeOf(Grammar[gri]->lhs);
+        for (SymbolNode* rhsItr = Grammar[gri]->rhs->head; rhsItr; rhsItr = rhsItr->next)
+            symbols[symbolCount++] = symbolCodeOf(rhsItr->symbol);
     }
+    ruleStart[numOfRules] = symbolCount;
     
     // Compute FIRST and FOLLOW sets
-    computeFirstSets();
-    computeFollowSets();
+    FlatGrammar flat = { numOfRules, NT_NOT_FOUND, program, ruleStart, ruleLhs, symbols };
+    solveFirstFollow(&flat, AutoFirst, AutoFollow);
+}
+
+/**
+ * Builds the tables for the grammar file and freezes them into frozenTables:
+ * tables generated at build time or cached for this grammar are used as they
+ * are, others are computed and cached. Runs once, under parserTablesOnce
+ */
+static void buildParserTables() {
+    epsilonStorage.entry.tokenType = EPS;
+    epsilonStorage.entry.id = NO_SYMBOL_ID;
+    epsilonStorage.entry.length = (unsigned short)strlen("EPSILON");
+    memcpy(epsilonStorage.bytes + offsetof(SymbolTableEntry, lexeme), "EPSILON", sizeof("EPSILON"));
+    
+    initTokenStrings();
+    initializeNonTerminalToString();
+    if (!loadGrammarTables(GRAMMAR_FILE))
+        return;
+#ifdef COMB_PARSE_TABLE
+    buildCombTable(&combParseTable, ruleTable, NT_NOT_FOUND, TK_NOT_FOUND, false);
+#endif
+    frozenTables.grammarHash = loadedGrammarHash;
+    frozenTables.rules = compiledRules;
+    frozenTables.cells = ruleTable;
+#ifdef CONSTEXPR_PARSE_TABLE
+    if (loadedGrammarHash == constexprGrammarHash)
+        frozenTables.cells = constexprRuleTable;
+#endif
+    frozenTables.follow = AutoFollow;
+    frozenTables.unitChainStart = unitChainStart;
+    frozenTables.unitChainRules = unitChainRules;
 }
 
 /**
- * Wrapper function for the parser. Initializes data structures, reads the grammar,
- * computes FIRST/FOLLOW sets, builds the parse table, and parses the input source code.
+ * Returns the tables every parse uses, building them on the first call.
+ * pthread_once() makes concurrent first calls wait for a single build and
+ * orders it before every return, so parsing threads read the tables
+ * without locks. The grammar is not reloaded afterwards
  *
- * @param inpFile The input source code file
+ * @return The frozen tables, or NULL if no grammar could be loaded
+ */
+const ParserTables* initializeParserTables() {
+    pthread_once(&parserTablesOnce, buildParserTables);
+    return frozenTables.rules ? &frozenTables : NULL;
+}
+
+/**
+ * Initializes the grammar data structures if needed, parses the tokens read
+ * through the cursor and prints the parse tree (or a syntax error notice)
+ *
+ * @param input Cursor over the tokens to parse
  * @param opFile The output file for the parse tree
+ * @param options Settings of the parse, NULL for the defaults
  */
-void parseInputSourceCode(char* inpFile, char* opFile) {
-    // Open input file
-    FILE* ifp = fopen(inpFile, "r");
-    if (!ifp) {
-        fprintf(stderr, "Could not open input file for parsing\n");
+void parseAndPrint(TokenCursor* input, char* opFile, const ParseOptions* options) {
+    // The tables are built by the first parse in the process and shared by all
+    const ParserTables* tables = initializeParserTables();
+    if (!tables) {
+        fprintf(stderr, "No grammar tables available. Parsing failed\n");
         return;
     }
-    
-    // Lex the input file
-    TokenList* tokensFromLexer = lexInput(ifp, opFile);
-    fclose(ifp);
-    
-    // Initialize data structures
-    initializeNonTerminalToString();
-    readGrammar();
-    initializeAndComputeFirstAndFollow();
     // printComputedFirstAndFollow();  // Uncomment if needed
-    initializeParseTable();
     // printParseTable();  // Uncomment if needed
 
     // Parse the tokens and build the parse tree
     bool hasSyntaxError = false;
-    ParseTree* parseTree = parseTokens(tokensFromLexer, &hasSyntaxError);
+    ParseTree* parseTree = parseTokens(tables, input, options, &hasSyntaxError);
     
     // Print the parse tree if no syntax errors
     if (!hasSyntaxError)
@@ -1237,9 +1188,121 @@ void parseInputSourceCode(char* inpFile, char* opFile) {
         FILE* foptp = fopen(opFile, "w");
         if (!foptp) {
             fprintf(stderr, "Could not open file for printing parser output\n");
-            return;
+        } else {
+            fprintf(foptp, "There were syntax errors in the input file. Not printing the parse tree!\nCheck the console for error details.");
+            fclose(foptp);
         }
-        fprintf(foptp, "There were syntax errors in the input file. Not printing the parse tree!\nCheck the console for error details.");
-        fclose(foptp);
     }
+    freeParseTree(parseTree);
+}
+
+/**
+ * Parses the tokens of a token buffer and prints the parse tree
+ *
+ * @param tokens The tokens to parse
+ * @param opFile The output file for the parse tree
+ * @param options Settings of the parse, NULL for the defaults
+ */
+void parseTokenBuffer(TokenBuffer* tokens, char* opFile, const ParseOptions* options) {
+    TokenCursor input;
+    openBufferCursor(&input, tokens);
+    parseAndPrint(&input, opFile, options);
+}
+
+/**
+ * Parses the tokens of a packed token stream and prints the parse tree
+ *
+ * @param packed The packed tokens to parse
+ * @param opFile The output file for the parse tree
+ * @param options Settings of the parse, NULL for the defaults
+ */
+void parsePackedTokens(PackedTokens* packed, char* opFile, const ParseOptions* options) {
+    TokenCursor input;
+    openPackedCursor(&input, packed);
+    parseAndPrint(&input, opFile, options);
+}
+
+/**
+ * Wrapper function for the parser. Lexes the input source code, then initializes
+ * the grammar data structures, parses the tokens and prints the parse tree.
+ *
+ * @param inpFile The input source code file
+ * @param opFile The output file for the parse tree
+ * @param options Settings of the parse, NULL for the defaults
+ */
+void parseInputSourceCode(char* inpFile, char* opFile, const ParseOptions* options) {
+    // Open input file
+    FILE* ifp = fopen(inpFile, "r");
+    if (!ifp) {
+        fprintf(stderr, "Could not open input file for parsing\n");
+        return;
+    }
+    
+    // Lex the input file
+    TokenBuffer* tokensFromLexer = lexInput(ifp, opFile, registerSourceFile(inpFile));
+    fclose(ifp);
+    
+    parseTokenBuffer(tokensFromLexer, opFile, options);
+    
+    // Everything allocated for this compilation is released in one step
+    freeTokenBuffer(tokensFromLexer);
+    resetArena(&compilationArena);
+}
+
+/**
+ * Parses a previously saved binary token stream, skipping lexical analysis
+ *
+ * @param streamFile The token stream file written by writeTokenStream()
+ * @param opFile The output file for the parse tree
+ * @param options Settings of the parse, NULL for the defaults
+ */
+void parseTokenStream(char* streamFile, char* opFile, const ParseOptions* options) {
+    TokenBuffer* tokens = mapTokenStream(streamFile);
+    if (!tokens) {
+        fprintf(stderr, "Could not read token stream %s\n", streamFile);
+        return;
+    }
+    
+    parseTokenBuffer(tokens, opFile, options);
+    
+    freeTokenBuffer(tokens);
+    resetArena(&compilationArena);
+}
+
+/**
+ * Low-memory variant of parseInputSourceCode(): the tokens are packed right after
+ * lexing and the token buffer is released before parsing starts
+ *
+ * @param inpFile The input source code file
+ * @param opFile The output file for the parse tree
+ * @param options Settings of the parse, NULL for the defaults
+ */
+void parseInputSourceCodePacked(char* inpFile, char* opFile, const ParseOptions* options) {
+    FILE* ifp = fopen(inpFile, "r");
+    if (!ifp) {
+        fprintf(stderr, "Could not open input file for parsing\n");
+        return;
+    }
+    
+    TokenBuffer* tokensFromLexer = lexInput(ifp, opFile, registerSourceFile(inpFile));
+    fclose(ifp);
+    if (!tokensFromLexer) {
+        fprintf(stderr, "Token buffer from lexer is NULL. Parsing failed\n");
+        resetArena(&compilationArena);
+        return;
+    }
+    PackedTokens* packed = packTokenBuffer(tokensFromLexer);
+    freeTokenBuffer(tokensFromLexer);
+    if (!packed) {
+        fprintf(stderr, "Could not pack the tokens of %s. Parsing failed\n", inpFile);
+        resetArena(&compilationArena);
+        return;
+    }
+    if (debugPrint)
+        printf("Packed %d tokens into %zu bytes\n", packed->count, packed->size);
+    
+    parsePackedTokens(packed, opFile, options);
+    
+    freePackedTokens(packed);
+    resetArena(&compilationArena);
 }
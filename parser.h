@@ -15,8 +15,39 @@
 
 #include "lexer.h"
 #include "parserDef.h"
-
-void parseInputSourceCode(char* inputFile,char* outputFile );
+#include "tokenPack.h"
+#include "stack.h"
+
+// Parse entry points; options may be NULL for the default settings
+void parseInputSourceCode(char* inputFile,char* outputFile, const ParseOptions* options);
+void parseTokenBuffer(TokenBuffer* tokens, char* outputFile, const ParseOptions* options);
+void parseTokenStream(char* streamFile, char* outputFile, const ParseOptions* options);
+void parsePackedTokens(PackedTokens* packed, char* outputFile, const ParseOptions* options);
+void parseInputSourceCodePacked(char* inputFile, char* outputFile, const ParseOptions* options);
+
+// Build the grammar tables on the first call from any thread and return the
+// frozen tables every later call shares; NULL if no grammar could be loaded
+const ParserTables* initializeParserTables();
+void initializeNonTerminalToString();
+bool readGrammar(const char* path);
+void initializeAndComputeFirstAndFollow();
+void initializeParseTable();
+void compileRules();
+void buildUnitChains();
+RuleIndex* newRuleTable();
+uint64_t hashGrammarFile(const char* path);
+SymbolNode* createSymbolNode(SymbolUnit* su);
+SymbolList* createSymbolList();
+void insertSymbolNode(SymbolList* symList, SymbolNode* node);
+ParseTree* createParseTree(SymbolTable* symbols);
+void freeParseTree(ParseTree* tree);
+uint32_t addChildren(ParseTree* tree, uint32_t parent, int count);
+bool expandRule(ParseTree* tree, Stack* stack, uint32_t parent, const CompiledRule* rule);
+SymbolTableEntry* parseNodeEntry(const ParseTree* tree, const ParseNode* node);
+
+#ifdef STATIC_GRAMMAR_TABLES
+extern const uint64_t staticGrammarHash;
+#endif
 
 
 #endif
@@ -17,9 +17,7 @@
 
 
 #define NON_TERMINAL_COUNT 30
-#define MAX_GRAMMAR_RULES 100
-#define MAX_RULE_LENGTH 512
-#define INIT_CHILD_CAPACITY 10
+#define GRAMMAR_FILE "grammar.txt"
 
 typedef enum NonTerminal{
     program,
@@ -80,6 +78,18 @@ typedef enum NonTerminal{
 
 extern char* nonTerminalToString[NT_NOT_FOUND];
 
+// SymbolCode: Terminals and non-terminals in one 16-bit space; non-terminals follow the tokens.
+typedef uint16_t SymbolCode;
+#define NT_CODE(nt)        ((SymbolCode)(TK_NOT_FOUND + (int)(nt)))
+#define IS_NT_CODE(code)   ((code) >= TK_NOT_FOUND)
+#define CODE_TO_NT(code)   ((NonTerminal)((code) - TK_NOT_FOUND))
+#define SYMBOL_CODE_COUNT  (TK_NOT_FOUND + NT_NOT_FOUND)
+
+// TokenSet: One bit per token; every token fits in a single word.
+typedef uint64_t TokenSet;
+#define TOKEN_BIT(tk)      ((TokenSet) 1 << (tk))
+#define IN_TOKEN_SET(set, tk)  (((set) & TOKEN_BIT(tk)) != 0)
+
 typedef struct SymbolUnit{
     bool isNonTerminal;
     union{
@@ -105,40 +115,108 @@ typedef struct GrammarRule{
     SymbolList* rhs;
 } GrammarRule;
 
-extern GrammarRule* Grammar[MAX_GRAMMAR_RULES];
+// Code of a grammar symbol in the SymbolCode space
+static inline SymbolCode symbolCodeOf(const SymbolUnit* su) {
+    return su->isNonTerminal ? NT_CODE(su->value.nt) : (SymbolCode) su->value.t;
+}
+
+// Grammar symbol of a code in the SymbolCode space
+static inline void symbolFromCode(SymbolUnit* su, SymbolCode code) {
+    su->isNonTerminal = IS_NT_CODE(code);
+    if (su->isNonTerminal)
+        su->value.nt = CODE_TO_NT(code);
+    else
+        su->value.t = (Token) code;
+}
+
+extern GrammarRule** Grammar;
 extern int numOfRules;
 
-typedef struct FirstFollowNode{
-    Token tk;
-    struct FirstFollowNode* next;
-} FirstFollowNode;
+// CompiledRule: A rule's right-hand side as packed symbol codes, for expansion.
+typedef struct CompiledRule {
+    NonTerminal lhs;
+    int length;               // Number of RHS symbols
+    const SymbolCode* rhs;    // RHS symbols in grammar order
+    const SymbolCode* push;   // The same symbols last to first, the order they go onto the stack
+} CompiledRule;
 
-typedef struct FirstFollowSet{
-    FirstFollowNode* head;
-    FirstFollowNode* tail;
-} FirstFollowSet;
+// Compiled form of Grammar[i] at index i
+extern CompiledRule* compiledRules;
 
-extern FirstFollowSet** First;
-extern FirstFollowSet** Follow;
-extern FirstFollowSet** AutoFirst;
-extern FirstFollowSet** AutoFollow;
+// FIRST and FOLLOW sets, indexed by non-terminal
+extern TokenSet* First;
+extern TokenSet* Follow;
+extern TokenSet* AutoFirst;
+extern TokenSet* AutoFollow;
 
 extern GrammarRule*** parseTable;
 
+// RuleIndex: Dense parse table cell; the rule to expand is Grammar[index - 1].
+typedef uint16_t RuleIndex;
+#define NO_RULE            0     // Cell value of an error entry
+#define PARSE_TABLE_ALIGN  64    // The dense table starts on a cache line
+#define RULE_TABLE_CELL(nt, tk)  ruleTable[(nt) * TK_NOT_FOUND + (tk)]
+
+// Parse table as one block of NT_NOT_FOUND x TK_NOT_FOUND rule indices
+extern RuleIndex* ruleTable;
+
+// Unit chains: when a cell's rule is a unit production A -> B, the rules
+// applied on the same token until one consumes a terminal or branches.
+// A chain is stored as its length followed by its rule indices in order.
+#define UNIT_CHAIN_CELL(nt, tk)  unitChainStart[(nt) * TK_NOT_FOUND + (tk)]
+extern uint32_t* unitChainStart;   // Offset of each cell's chain in unitChainRules, 0 for none
+extern RuleIndex* unitChainRules;  // All chains, end to end after an unused slot 0
+
+// Set by the steps that build the tables above; they run once per process
+// under initializeParserTables(), or in single-threaded tools
 extern bool grammarLoaded;
 extern bool nonTerminalsInitialized;
 extern bool firstFollowComputed;
 extern bool parseTreeInitialized;
-
-typedef struct ParseNode{
-    SymbolUnit* symbol;
-    SymbolTableEntry* ste;
-    struct ParseNode** children;
-    int capacity, size, lineNumber;
+extern uint64_t loadedGrammarHash;
+
+// ParserTables: The tables parseTokens() reads, frozen once they are built.
+// One instance is published per process and shared read-only by all threads.
+typedef struct ParserTables {
+    uint64_t grammarHash;             // Grammar the tables were built from
+    const CompiledRule* rules;        // compiledRules
+    const RuleIndex* cells;           // Dense table in the layout of ruleTable
+    const TokenSet* follow;           // FOLLOW of every non-terminal, for error recovery
+    const uint32_t* unitChainStart;   // As unitChainStart
+    const RuleIndex* unitChainRules;  // As unitChainRules
+} ParserTables;
+
+// ParseNode: One node of a ParseTree in 16 bytes. The symbol is stored as
+// its code and nodes refer to each other by index into the tree's array.
+typedef struct ParseNode {
+    SymbolCode code;        // Token, or NT_CODE() of a non-terminal
+    uint16_t childCount;    // Number of children
+    uint32_t firstChild;    // Index of the first child; its siblings follow it
+    uint32_t symbolId;      // Terminals: symbol id of the matched token, else NO_SYMBOL_ID
+    uint32_t lineNumber;    // Line the parser reached the node on, 0 if never
 } ParseNode;
 
-typedef struct ParseTree{
-    ParseNode* root;
+#define PARSE_TREE_ROOT           0            // Index of the root node
+#define NO_PARSE_NODE             UINT32_MAX   // Index of no node
+#define INIT_PARSE_TREE_CAPACITY  4096         // Nodes a tree starts with room for
+#define MAX_PARSE_TREE_NODES      (UINT32_MAX - 1)
+
+// ParseTree: All nodes of one parse in a single array that grows by doubling.
+// Symbol ids live as long as the tree's symbol table; EPS leaves all share
+// one entry, see parseNodeEntry().
+typedef struct ParseTree {
+    ParseNode* nodes;              // Root first; children of a node are consecutive
+    uint32_t count;                // Nodes in use
+    uint32_t capacity;             // Nodes allocated
+    SymbolTable* symbols;          // Table the symbol ids refer to
+    bool elideEpsilonLeaves;       // Built without EPS leaves, see ParseOptions
 } ParseTree;
 
+// ParseOptions: Settings of one parse, passed to the parse entry points;
+// a NULL pointer means the defaults (all false).
+typedef struct ParseOptions {
+    bool elideEpsilonLeaves;   // Leave EPS leaves out: a non-terminal that derives
+                               // the empty string is kept, childless
+} ParseOptions;
+
 #endif
@@ -0,0 +1,220 @@
+/*
+   ====================================================================
+   Source Locations Implementation
+   --------------------------------------------------------------------
+   Keeps the table of registered source files and their lazily built
+   line-start indexes. Resolving a location is a binary search for the
+   last line starting at or before its offset. Parses on several threads
+   register and resolve files at once, so the table and the indexes are
+   only touched under sourceFilesLock.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "sourceLoc.h"
+#include "newline.h"
+
+#define LINE_INDEX_CHUNK  (64 * 1024)   // Bytes read per step while indexing a file
+
+// SourceFile: A registered file and its line-start index (NULL until first needed).
+typedef struct SourceFile {
+    char* path;              // Path the file was registered with
+    uint32_t* lineStarts;    // Offset of the first character of every line
+    uint32_t lineCount;      // Number of entries in lineStarts
+} SourceFile;
+
+// Registered files; index 0 is unused so that id 0 can mean "no location"
+static SourceFile* sourceFiles = NULL;
+static int sourceFileCount = 0;
+static int sourceFileCapacity = 0;
+static pthread_mutex_t sourceFilesLock = PTHREAD_MUTEX_INITIALIZER;
+
+// ------------------------- FILE REGISTRY -------------------------
+
+static SourceFileId addSourceFile(const char* path) {
+    /*
+       Looks the path up among the registered files and adds it when missing.
+       Files are few, so a linear scan is enough. Called with the lock held.
+    */
+    for (int i = 1; i < sourceFileCount; i++) {
+        if (strcmp(sourceFiles[i].path, path) == 0)
+            return (SourceFileId) i;
+    }
+    if (sourceFileCount == 0)
+        sourceFileCount = 1;
+    if (sourceFileCount > MAX_SOURCE_FILES) {
+        fprintf(stderr, "Too many source files registered\n");
+        return 0;
+    }
+
+    if (sourceFileCount == sourceFileCapacity || !sourceFiles) {
+        int newCapacity = sourceFileCapacity ? sourceFileCapacity * 2 : 8;
+        SourceFile* grown = (SourceFile*) realloc(sourceFiles, newCapacity * sizeof(SourceFile));
+        if (!grown) {
+            fprintf(stderr, "Memory allocation failed for the source file table\n");
+            return 0;
+        }
+        sourceFiles = grown;
+        sourceFileCapacity = newCapacity;
+    }
+
+    SourceFile* file = &sourceFiles[sourceFileCount];
+    file->path = strdup(path);
+    file->lineStarts = NULL;
+    file->lineCount = 0;
+    if (!file->path) {
+        fprintf(stderr, "Memory allocation failed for a source file path\n");
+        return 0;
+    }
+    return (SourceFileId) sourceFileCount++;
+}
+
+SourceFileId registerSourceFile(const char* path) {
+    /*
+       Registers the path under the lock; any thread may call this.
+    */
+    if (!path) return 0;
+    pthread_mutex_lock(&sourceFilesLock);
+    SourceFileId id = addSourceFile(path);
+    pthread_mutex_unlock(&sourceFilesLock);
+    return id;
+}
+
+const char* sourceFilePath(SourceFileId file) {
+    /*
+       Returns the registered path, or NULL for an unknown id. The path
+       string itself never moves, so it stays valid after the lock is
+       released, until freeSourceFiles().
+    */
+    const char* path = NULL;
+    pthread_mutex_lock(&sourceFilesLock);
+    if (file != 0 && file < sourceFileCount)
+        path = sourceFiles[file].path;
+    pthread_mutex_unlock(&sourceFilesLock);
+    return path;
+}
+
+void freeSourceFiles() {
+    /*
+       Releases every path and line index and forgets all file ids.
+       No location may be resolved concurrently or afterwards.
+    */
+    pthread_mutex_lock(&sourceFilesLock);
+    for (int i = 1; i < sourceFileCount; i++) {
+        free(sourceFiles[i].path);
+        free(sourceFiles[i].lineStarts);
+    }
+    free(sourceFiles);
+    sourceFiles = NULL;
+    sourceFileCount = 0;
+    sourceFileCapacity = 0;
+    pthread_mutex_unlock(&sourceFilesLock);
+}
+
+// ------------------------- LINE INDEX -------------------------
+
+static bool buildLineIndex(SourceFile* file) {
+    /*
+       Reads the file once and records the offset at which every line begins.
+       Line 1 always begins at offset 0. Each chunk is counted first so the
+       index grows at most once per chunk, then its line starts are copied in.
+    */
+    FILE* fp = fopen(file->path, "rb");
+    if (!fp) {
+        fprintf(stderr, "Cannot open %s to index its lines\n", file->path);
+        return false;
+    }
+
+    uint32_t capacity = 256;
+    uint32_t* starts = (uint32_t*) malloc(capacity * sizeof(uint32_t));
+    if (!starts) {
+        fprintf(stderr, "Memory allocation failed for the line index\n");
+        fclose(fp);
+        return false;
+    }
+    uint32_t count = 0;
+    starts[count++] = 0;
+
+    char* chunk = (char*) malloc(LINE_INDEX_CHUNK);
+    if (!chunk) {
+        fprintf(stderr, "Memory allocation failed for the line index\n");
+        free(starts);
+        fclose(fp);
+        return false;
+    }
+    uint32_t base = 0;
+    size_t bytesRead;
+    while ((bytesRead = fread(chunk, 1, LINE_INDEX_CHUNK, fp)) > 0) {
+        size_t lines = countNewlines(chunk, bytesRead);
+        if (count + lines > capacity) {
+            while (count + lines > capacity)
+                capacity *= 2;
+            uint32_t* grown = (uint32_t*) realloc(starts, capacity * sizeof(uint32_t));
+            if (!grown) {
+                fprintf(stderr, "Failed to resize the line index\n");
+                free(starts);
+                free(chunk);
+                fclose(fp);
+                return false;
+            }
+            starts = grown;
+        }
+        count += (uint32_t) collectLineStarts(chunk, bytesRead, base, starts + count);
+        base += (uint32_t) bytesRead;
+    }
+    free(chunk);
+    fclose(fp);
+
+    file->lineStarts = starts;
+    file->lineCount = count;
+    return true;
+}
+
+bool resolveSourceLoc(SourceLoc loc, uint32_t* line, uint32_t* column) {
+    /*
+       Finds the line containing the location's offset by binary search
+       over the line starts; the column is the distance from that start.
+       The lock is held throughout, since the first resolution in a file
+       builds its index and a registration may move the file table.
+    */
+    SourceFileId id = sourceLocFile(loc);
+    pthread_mutex_lock(&sourceFilesLock);
+    if (id == 0 || id >= sourceFileCount) {
+        pthread_mutex_unlock(&sourceFilesLock);
+        return false;
+    }
+    SourceFile* file = &sourceFiles[id];
+    if (!file->lineStarts && !buildLineIndex(file)) {
+        pthread_mutex_unlock(&sourceFilesLock);
+        return false;
+    }
+
+    uint32_t offset = sourceLocOffset(loc);
+    uint32_t lo = 0, hi = file->lineCount - 1;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        if (file->lineStarts[mid] <= offset)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    if (line) *line = lo + 1;
+    if (column) *column = offset - file->lineStarts[lo] + 1;
+    pthread_mutex_unlock(&sourceFilesLock);
+    return true;
+}
+
+void printSourceLoc(FILE* fp, SourceLoc loc) {
+    /*
+       Prints the location in the usual compiler diagnostic form.
+    */
+    uint32_t line, column;
+    if (!resolveSourceLoc(loc, &line, &column)) {
+        fprintf(fp, "<unknown>");
+        return;
+    }
+    fprintf(fp, "%s:%u:%u", sourceFilePath(sourceLocFile(loc)), line, column);
+}
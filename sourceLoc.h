@@ -0,0 +1,66 @@
+/*
+   ====================================================================
+   Source Locations - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   A SourceLoc packs the position of a token into 64 bits:
+
+     bits 63-48 : source file id (0 means no location)
+     bits 47-32 : length in bytes, saturated at 0xFFFF
+     bits 31-0  : byte offset of the first character
+
+   Only offsets are recorded while lexing. Lines and columns are
+   recovered on demand from a per-file index of line starts, built
+   the first time a location in that file is resolved. The functions
+   below may be called from any thread.
+   ====================================================================
+*/
+
+#ifndef SOURCE_LOC_H
+#define SOURCE_LOC_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Constant Definitions */
+#define NO_SOURCE_LOC          ((SourceLoc) 0)   // Location of synthesized tokens and nodes
+#define MAX_SOURCE_FILES       0xFFFF            // File ids run from 1 to this value
+#define SOURCE_LOC_MAX_LENGTH  0xFFFF            // Longer spans are clipped to this length
+
+typedef uint64_t SourceLoc;
+typedef uint16_t SourceFileId;
+
+// Build a location from its parts.
+static inline SourceLoc makeSourceLoc(SourceFileId file, uint32_t offset, uint32_t length) {
+    if (length > SOURCE_LOC_MAX_LENGTH)
+        length = SOURCE_LOC_MAX_LENGTH;
+    return ((SourceLoc) file << 48) | ((SourceLoc) length << 32) | offset;
+}
+
+// Source file id of a location.
+static inline SourceFileId sourceLocFile(SourceLoc loc) { return (SourceFileId)(loc >> 48); }
+
+// Byte offset of a location.
+static inline uint32_t sourceLocOffset(SourceLoc loc) { return (uint32_t) loc; }
+
+// Length of a location.
+static inline uint32_t sourceLocLength(SourceLoc loc) { return (uint32_t)(loc >> 32) & SOURCE_LOC_MAX_LENGTH; }
+
+/* ----------- Source File Functions ----------- */
+// Register a source file by path and return its id; a path already registered keeps its id.
+// Returns 0 when no more files can be registered.
+SourceFileId registerSourceFile(const char* path);
+
+// Get the path a source file id was registered with.
+const char* sourceFilePath(SourceFileId file);
+
+// Resolve a location to a 1-based line and column. Returns false for unknown locations.
+bool resolveSourceLoc(SourceLoc loc, uint32_t* line, uint32_t* column);
+
+// Print a location as "path:line:column".
+void printSourceLoc(FILE* fp, SourceLoc loc);
+
+// Release all registered files and their line indexes.
+void freeSourceFiles();
+
+#endif
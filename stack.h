@@ -1,24 +1,48 @@
 #ifndef STACK_H
 #define STACK_H
 
-#include "parserDef.h"  // Ensure it includes the definition of ParseNode
+#include "parserDef.h"  // Ensure it includes the definition of NO_PARSE_NODE
 
-typedef struct StackItem {
-    ParseNode* data;
-    struct StackItem* next;
-} StackItem;
-
-typedef StackItem* StackNode;
+#define INIT_STACK_CAPACITY 256   // Entries the parse stack starts with
 
+// Stack: Contiguous array of parse node indices, bottom first, grown by
+// doubling inside the compilation arena. Pushes and pops only move the size.
 typedef struct Stack {
-    StackNode top;
+    uint32_t* items;
+    int size;
+    int capacity;
 } Stack;
 
 // Stack function declarations
 Stack* initializeStack();
-void pushStack(Stack* stack, ParseNode* node);
-void popStack(Stack* stack);
-ParseNode* peekStack(Stack* stack);
-bool isStackEmpty(Stack* stack);
+void growStack(Stack* stack, int count);
+
+// The operations parseTokens() runs per symbol are inline
+
+// Make room for at least count more entries
+static inline void reserveStack(Stack* stack, int count) {
+    if (stack->size + count > stack->capacity)
+        growStack(stack, count);
+}
+
+static inline bool isStackEmpty(Stack* stack) {
+    return stack->size == 0;
+}
+
+static inline void pushStack(Stack* stack, uint32_t node) {
+    reserveStack(stack, 1);
+    stack->items[stack->size++] = node;
+}
+
+// Removes the top entry, if any
+static inline void popStack(Stack* stack) {
+    if (!isStackEmpty(stack))
+        stack->size--;
+}
+
+// Top entry, or NO_PARSE_NODE when the stack is empty
+static inline uint32_t peekStack(Stack* stack) {
+    return isStackEmpty(stack) ? NO_PARSE_NODE : stack->items[stack->size - 1];
+}
 
 #endif  // STACK_H
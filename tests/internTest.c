@@ -0,0 +1,126 @@
+/*
+   ====================================================================
+   Intern Table Capacity Test
+   --------------------------------------------------------------------
+   Fills an InternTable to its last slot and checks that it then refuses
+   new lexemes without disturbing the ones it holds, that numbers are
+   published with their values already converted, that a lexer
+   interning into a full table stops with no token buffer instead of
+   producing tokens without symbol ids, and that getTokenEntry() rejects
+   symbol ids outside the table.
+
+   Usage: internTest (exits with 1 on the first failed check)
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "lexer.h"
+#include "arena.h"
+#include "intern.h"
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1); \
+        } \
+    } while (0)
+
+// Field names "xxxx", "xxxy", ...: distinct lexemes that are not keywords
+static void fieldName(int n, char* name) {
+    for (int i = 3; i >= 0; i--, n /= 3)
+        name[i] = "xyz"[n % 3];
+    name[4] = '\0';
+}
+
+// A temporary program made of count distinct field names, one per line
+static FILE* programOfNames(int count) {
+    FILE* fp = tmpfile();
+    CHECK(fp != NULL);
+    char name[8];
+    for (int n = 0; n < count; n++) {
+        fieldName(n, name);
+        fprintf(fp, "%s\n", name);
+    }
+    rewind(fp);
+    return fp;
+}
+
+static void testFullTable() {
+    InternTable* table = createInternTable(1);
+    CHECK(table->capacity == MIN_INTERN_CAPACITY);
+
+    char name[8];
+    for (uint32_t n = 0; n < table->capacity; n++) {
+        fieldName((int) n, name);
+        SymbolTableEntry* interned = internEntry(table, newSymbolTableEntry(name, FIELDID));
+        CHECK(interned != NULL);
+        CHECK(interned->id < table->capacity);
+        CHECK(internEntryAt(table, interned->id) == interned);
+    }
+    CHECK(internCount(table) == table->capacity);
+
+    // A new lexeme has no slot left; those already present are still found
+    fieldName((int) table->capacity, name);
+    CHECK(internEntry(table, newSymbolTableEntry(name, FIELDID)) == NULL);
+    fieldName(0, name);
+    SymbolTableEntry* first = internEntry(table, newSymbolTableEntry(name, FIELDID));
+    CHECK(first != NULL && first == internLookup(table, name, 4));
+    CHECK(internEntryAt(table, table->capacity) == NULL);
+
+    destroyInternTable(table);
+    resetArena(&compilationArena);
+}
+
+static void testNumbersConvertedWhenInterned() {
+    // Readers on other threads must find the value ready, never convert it
+    InternTable* table = createInternTable(1);
+    SymbolTable* shared = newSharedSymbolTable(table);
+    SymbolTableEntry* entry = newSymbolTableEntry("25.50E+01", RNUM);
+    CHECK(addToken(shared, entry));
+    SymbolTableEntry* interned = getSymbolEntry(shared, entry->id);
+    CHECK(interned != NULL && interned != entry);
+    CHECK(interned->valueReady && interned->numericValue == 255.0);
+
+    destroyInternTable(table);
+    resetArena(&compilationArena);
+}
+
+static void testLexingIntoFullTable() {
+    // Twice the lexemes the smallest table holds: lexing must stop cleanly
+    InternTable* small = createInternTable(1);
+    FILE* fp = programOfNames(2 * MIN_INTERN_CAPACITY);
+    CHECK(getAllTokensShared(fp, 0, small) == NULL);
+    fclose(fp);
+    destroyInternTable(small);
+    resetArena(&compilationArena);
+
+    // The same program in a table sized for it keeps every symbol
+    InternTable* large = createInternTable(4 * MIN_INTERN_CAPACITY);
+    fp = programOfNames(2 * MIN_INTERN_CAPACITY);
+    TokenBuffer* tokens = getAllTokensShared(fp, 0, large);
+    fclose(fp);
+    CHECK(tokens != NULL);
+    CHECK(tokens->count == 2 * MIN_INTERN_CAPACITY + 1);
+    for (int i = 0; i < tokens->count; i++)
+        CHECK(getTokenEntry(tokens, i) != NULL);
+
+    // Ids outside the table resolve to nothing
+    tokens->symbolId[0] = UINT32_MAX;
+    CHECK(getTokenEntry(tokens, 0) == NULL);
+    tokens->symbolId[0] = large->capacity;
+    CHECK(getTokenEntry(tokens, 0) == NULL);
+
+    freeTokenBuffer(tokens);
+    destroyInternTable(large);
+    resetArena(&compilationArena);
+}
+
+int main() {
+    initTokenStrings();
+    testFullTable();
+    testNumbersConvertedWhenInterned();
+    testLexingIntoFullTable();
+    printf("internTest passed\n");
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+   ====================================================================
+   Source Location Test
+   --------------------------------------------------------------------
+   Writes a file whose layout is known, then checks that locations at
+   chosen byte offsets resolve to the right line and column, including
+   past the first 64 KB chunk of the line index, that the spans the
+   lexer records resolve to where their tokens start, and that
+   printSourceLoc() prints "path:line:column".
+
+   Usage: sourceLocTest (exits with 1 on the first failed check)
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "lexer.h"
+#include "arena.h"
+#include "sourceLoc.h"
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1); \
+        } \
+    } while (0)
+
+#define FILLER_LINES  20000   // "xxxx\n" lines, 100 KB in all
+
+// Layout of the test file:
+//   line 1             "abc def\n"      offsets 0-7
+//   line 2             "\n"             offset 8
+//   line 3             "  ghi\n"        offsets 9-14
+//   lines 4 to 20003   "xxxx\n"         from offset 15, 5 bytes each
+//   line 20004         "zz"             no final newline
+#define FILLER_START  15
+#define LAST_LINE     (3 + FILLER_LINES + 1)
+#define LAST_START    (FILLER_START + 5 * FILLER_LINES)
+
+static void writeTestFile(char* path) {
+    int fd = mkstemp(path);
+    CHECK(fd >= 0);
+    FILE* fp = fdopen(fd, "w");
+    CHECK(fp != NULL);
+    fputs("abc def\n\n  ghi\n", fp);
+    for (int i = 0; i < FILLER_LINES; i++)
+        fputs("xxxx\n", fp);
+    fputs("zz", fp);
+    fclose(fp);
+}
+
+static void checkResolves(SourceFileId file, uint32_t offset, uint32_t line, uint32_t column) {
+    uint32_t l = 0, c = 0;
+    CHECK(resolveSourceLoc(makeSourceLoc(file, offset, 1), &l, &c));
+    if (l != line || c != column) {
+        fprintf(stderr, "offset %u resolved to %u:%u, expected %u:%u\n", offset, l, c, line, column);
+        exit(1);
+    }
+}
+
+static void testKnownOffsets(SourceFileId file) {
+    checkResolves(file, 0, 1, 1);
+    checkResolves(file, 4, 1, 5);
+    checkResolves(file, 7, 1, 8);                     // The newline ends its own line
+    checkResolves(file, 8, 2, 1);                     // An empty line
+    checkResolves(file, 11, 3, 3);
+    checkResolves(file, FILLER_START, 4, 1);
+    checkResolves(file, 65536 + 3, 4 + (65536 + 3 - FILLER_START) / 5, 1 + (65536 + 3 - FILLER_START) % 5);
+    checkResolves(file, LAST_START + 1, LAST_LINE, 2);
+
+    // Unregistered files and "no location" do not resolve
+    CHECK(!resolveSourceLoc(NO_SOURCE_LOC, NULL, NULL));
+    CHECK(!resolveSourceLoc(makeSourceLoc(file + 1, 0, 1), NULL, NULL));
+}
+
+static void testTokenSpans(const char* path, SourceFileId file) {
+    FILE* fp = fopen(path, "r");
+    CHECK(fp != NULL);
+    TokenBuffer* tokens = getAllTokens(fp, file);
+    fclose(fp);
+    CHECK(tokens != NULL && tokens->span != NULL);
+    CHECK(tokens->count == 3 + FILLER_LINES + 1 + 1);
+
+    uint32_t line, column;
+    CHECK(resolveSourceLoc(tokens->span[1], &line, &column) && line == 1 && column == 5);
+    CHECK(sourceLocLength(tokens->span[1]) == 3);
+    CHECK(resolveSourceLoc(tokens->span[2], &line, &column) && line == 3 && column == 3);
+    CHECK(resolveSourceLoc(tokens->span[3 + FILLER_LINES - 1], &line, &column) && line == LAST_LINE - 1 && column == 1);
+    CHECK(resolveSourceLoc(tokens->span[3 + FILLER_LINES], &line, &column) && line == LAST_LINE && column == 1);
+    CHECK(strcmp(getTokenEntry(tokens, 3 + FILLER_LINES)->lexeme, "zz") == 0);
+
+    freeTokenBuffer(tokens);
+    resetArena(&compilationArena);
+}
+
+static void testPrintedForm(const char* path, SourceFileId file) {
+    char expected[4096 + 32], printed[4096 + 32];
+    snprintf(expected, sizeof(expected), "%s:3:3", path);
+
+    FILE* out = tmpfile();
+    CHECK(out != NULL);
+    printSourceLoc(out, makeSourceLoc(file, 11, 3));
+    rewind(out);
+    CHECK(fgets(printed, sizeof(printed), out) != NULL);
+    fclose(out);
+    CHECK(strcmp(printed, expected) == 0);
+}
+
+int main() {
+    char path[] = "/tmp/sourceLocTestXXXXXX";
+    writeTestFile(path);
+
+    SourceFileId file = registerSourceFile(path);
+    CHECK(file != 0);
+    CHECK(registerSourceFile(path) == file);
+    CHECK(strcmp(sourceFilePath(file), path) == 0);
+
+    testKnownOffsets(file);
+    testTokenSpans(path, file);
+    testPrintedForm(path, file);
+
+    freeSourceFiles();
+    remove(path);
+    printf("sourceLocTest passed\n");
+    return 0;
+}
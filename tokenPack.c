@@ -0,0 +1,202 @@
+/*
+   ====================================================================
+   Packed Token Stream Implementation
+   --------------------------------------------------------------------
+   Encoder and sequential decoder for the format described in
+   tokenPack.h, plus the TokenCursor used by the parser.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lexer.h"
+#include "tokenPack.h"
+
+// ------------------------- ENCODER -------------------------
+
+PackedTokens* createPackedTokens(SymbolTable* symbols) {
+    /*
+       Creates an empty packed stream. Deltas start from line 1.
+    */
+    PackedTokens* packed = (PackedTokens*) calloc(1, sizeof(PackedTokens));
+    if (!packed) {
+        fprintf(stderr, "Memory allocation failed for PackedTokens\n");
+        return NULL;
+    }
+    packed->bytes = (uint8_t*) malloc(INIT_PACKED_CAP);
+    if (!packed->bytes) {
+        fprintf(stderr, "Memory allocation failed for PackedTokens bytes\n");
+        free(packed);
+        return NULL;
+    }
+    packed->capacity = INIT_PACKED_CAP;
+    packed->lastLine = 1;
+    packed->symbols = symbols;
+    return packed;
+}
+
+static void putVarint(uint8_t** out, uint32_t value) {
+    /*
+       Writes an unsigned LEB128 varint: 7 bits per byte, high bit set
+       on every byte but the last.
+    */
+    while (value >= 0x80) {
+        *(*out)++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *(*out)++ = (uint8_t) value;
+}
+
+bool appendPackedToken(PackedTokens* packed, Token kind, uint32_t symbolId, uint32_t lineNum) {
+    /*
+       Encodes one token. Small forward line steps ride in the tag byte;
+       anything else is written as a zigzag varint after it. Returns false,
+       leaving the stream unchanged, when it cannot grow.
+    */
+    // Worst case: tag + two 5-byte varints
+    if (packed->size + 11 > packed->capacity) {
+        size_t newCapacity = packed->capacity * 2;
+        uint8_t* grown = (uint8_t*) realloc(packed->bytes, newCapacity);
+        if (!grown) {
+            fprintf(stderr, "Failed to resize PackedTokens (current size: %zu)\n", packed->size);
+            return false;
+        }
+        packed->bytes = grown;
+        packed->capacity = newCapacity;
+    }
+
+    uint8_t* out = packed->bytes + packed->size;
+    int32_t delta = (int32_t)(lineNum - packed->lastLine);
+    if (delta >= 0 && delta < PACKED_DELTA_ESCAPE) {
+        *out++ = (uint8_t)(kind | (delta << PACKED_DELTA_SHIFT));
+    } else {
+        *out++ = (uint8_t)(kind | (PACKED_DELTA_ESCAPE << PACKED_DELTA_SHIFT));
+        putVarint(&out, ((uint32_t) delta << 1) ^ (uint32_t)(delta >> 31));
+    }
+    putVarint(&out, symbolId);
+
+    packed->size = (size_t)(out - packed->bytes);
+    packed->lastLine = lineNum;
+    packed->count++;
+    return true;
+}
+
+PackedTokens* packTokenBuffer(TokenBuffer* tokens) {
+    /*
+       Encodes every token of the buffer, in order. A stream missing any
+       token is released rather than returned.
+    */
+    if (!tokens) return NULL;
+    PackedTokens* packed = createPackedTokens(tokens->symbols);
+    if (!packed) return NULL;
+    for (int i = 0; i < tokens->count; i++) {
+        if (!appendPackedToken(packed, (Token) tokens->kind[i], tokens->symbolId[i], tokens->lineNum[i])) {
+            freePackedTokens(packed);
+            return NULL;
+        }
+    }
+    return packed;
+}
+
+void freePackedTokens(PackedTokens* packed) {
+    /*
+       Releases the encoded bytes. The symbol table is left alone.
+    */
+    if (!packed) return;
+    free(packed->bytes);
+    free(packed);
+}
+
+// ------------------------- DECODER / CURSOR -------------------------
+
+static uint32_t getVarint(const uint8_t** in) {
+    /*
+       Reads an unsigned LEB128 varint; single-byte values take the fast path.
+    */
+    uint32_t byte = *(*in)++;
+    if (byte < 0x80)
+        return byte;
+    uint32_t value = byte & 0x7F;
+    int shift = 7;
+    do {
+        byte = *(*in)++;
+        value |= (byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+static void decodePackedToken(TokenCursor* cursor) {
+    /*
+       Decodes the token at packedPos into the cursor's current token.
+    */
+    if (cursor->packedPos >= cursor->packedEnd) {
+        cursor->atEnd = true;
+        return;
+    }
+    uint8_t tag = *cursor->packedPos++;
+    uint32_t delta = tag >> PACKED_DELTA_SHIFT;
+    if (delta == PACKED_DELTA_ESCAPE) {
+        uint32_t zz = getVarint(&cursor->packedPos);
+        delta = (zz >> 1) ^ (uint32_t)(-(int32_t)(zz & 1));
+    }
+    cursor->kind = (Token)(tag & PACKED_KIND_MASK);
+    cursor->lineNum += delta;
+    cursor->symbolId = getVarint(&cursor->packedPos);
+}
+
+void openBufferCursor(TokenCursor* cursor, TokenBuffer* tokens) {
+    /*
+       Positions the cursor on the first token of the buffer.
+    */
+    memset(cursor, 0, sizeof(TokenCursor));
+    cursor->buffer = tokens;
+    cursor->symbols = tokens->symbols;
+    cursor->index = -1;
+    advanceCursor(cursor);
+}
+
+void openPackedCursor(TokenCursor* cursor, PackedTokens* packed) {
+    /*
+       Positions the cursor on the first token of the packed stream.
+    */
+    memset(cursor, 0, sizeof(TokenCursor));
+    cursor->symbols = packed->symbols;
+    cursor->packedPos = packed->bytes;
+    cursor->packedEnd = packed->bytes + packed->size;
+    cursor->lineNum = 1;
+    cursor->index = -1;
+    advanceCursor(cursor);
+}
+
+void advanceCursor(TokenCursor* cursor) {
+    /*
+       Moves to the next token of whichever source the cursor reads.
+    */
+    if (cursor->atEnd)
+        return;
+    cursor->index++;
+    if (cursor->buffer) {
+        TokenBuffer* buf = cursor->buffer;
+        if (cursor->index >= buf->count) {
+            cursor->atEnd = true;
+            return;
+        }
+        cursor->kind = (Token) buf->kind[cursor->index];
+        cursor->symbolId = buf->symbolId[cursor->index];
+        cursor->lineNum = buf->lineNum[cursor->index];
+        cursor->loc = buf->span ? buf->span[cursor->index] : NO_SOURCE_LOC;
+    } else {
+        decodePackedToken(cursor);
+    }
+}
+
+SymbolTableEntry* cursorEntry(TokenCursor* cursor) {
+    /*
+       Returns the symbol table entry of the current token.
+    */
+    if (cursor->atEnd)
+        return NULL;
+    return getSymbolEntry(cursor->symbols, cursor->symbolId);
+}
@@ -0,0 +1,85 @@
+/*
+   ====================================================================
+   Packed Token Stream - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   A compressed in-memory token representation for very large inputs.
+   Each token is encoded as:
+
+     tag byte      : token kind in the low 6 bits, line delta (0-2) in
+                     the top 2 bits; 3 means a zigzag varint delta follows
+     [line delta]  : only present when the tag says so
+     symbol id     : unsigned LEB128 varint
+
+   Typical code takes two bytes per token. A TokenCursor walks either
+   a TokenBuffer or a PackedTokens stream sequentially for the parser.
+   ====================================================================
+*/
+
+#ifndef TOKEN_PACK_H
+#define TOKEN_PACK_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "lexerDef.h"
+
+/* Constant Definitions */
+#define PACKED_KIND_MASK        0x3F   // Bits of the tag byte holding the token kind
+#define PACKED_DELTA_SHIFT      6      // Position of the line delta in the tag byte
+#define PACKED_DELTA_ESCAPE     3      // Tag delta value announcing an explicit varint delta
+#define INIT_PACKED_CAP         1024   // Initial capacity of a packed stream in bytes
+
+// Every token kind, TK_NOT_FOUND excluded, must fit in the tag byte
+_Static_assert(TK_NOT_FOUND <= PACKED_KIND_MASK + 1, "token kinds no longer fit in the packed tag byte");
+
+// PackedTokens: Varint delta-encoded token stream.
+typedef struct PackedTokens {
+    uint8_t* bytes;          // Encoded tokens
+    size_t size;             // Bytes used
+    size_t capacity;         // Bytes allocated
+    int count;               // Number of tokens encoded
+    uint32_t lastLine;       // Line of the last encoded token (delta base)
+    SymbolTable* symbols;    // Symbol table the ids refer to
+} PackedTokens;
+
+// TokenCursor: Sequential reader over a token source.
+typedef struct TokenCursor {
+    Token kind;              // Kind of the current token
+    uint32_t symbolId;       // Symbol id of the current token
+    uint32_t lineNum;        // Line number of the current token
+    SourceLoc loc;           // Span of the current token, NO_SOURCE_LOC if the source has none
+    bool atEnd;              // Set once every token has been consumed
+    SymbolTable* symbols;    // Symbol table the ids refer to
+    TokenBuffer* buffer;     // Source buffer, or NULL when reading a packed stream
+    int index;               // Position of the current token
+    const uint8_t* packedPos;  // Next byte to decode in a packed stream
+    const uint8_t* packedEnd;  // End of the packed stream
+} TokenCursor;
+
+/* ----------- Packed Stream Functions ----------- */
+// Create an empty packed stream whose ids refer to the given symbol table.
+PackedTokens* createPackedTokens(SymbolTable* symbols);
+
+// Encode one token at the end of the packed stream; false if it could not grow.
+bool appendPackedToken(PackedTokens* packed, Token kind, uint32_t symbolId, uint32_t lineNum);
+
+// Encode a whole token buffer; NULL if it could not be encoded.
+PackedTokens* packTokenBuffer(TokenBuffer* tokens);
+
+// Release a packed stream.
+void freePackedTokens(PackedTokens* packed);
+
+/* ----------- Token Cursor Functions ----------- */
+// Position a cursor on the first token of a token buffer.
+void openBufferCursor(TokenCursor* cursor, TokenBuffer* tokens);
+
+// Position a cursor on the first token of a packed stream.
+void openPackedCursor(TokenCursor* cursor, PackedTokens* packed);
+
+// Move the cursor to the next token.
+void advanceCursor(TokenCursor* cursor);
+
+// Get the symbol table entry of the current token.
+SymbolTableEntry* cursorEntry(TokenCursor* cursor);
+
+#endif
@@ -0,0 +1,224 @@
+/*
+   ====================================================================
+   Binary Token Stream Implementation
+   --------------------------------------------------------------------
+   Writes a TokenBuffer in the layout described in tokenStream.h, and
+   maps such files back. Reading only walks the symbol records to
+   rebuild the symbol table; the token columns are used as they are.
+   ====================================================================
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "lexer.h"
+#include "tokenStream.h"
+
+// ------------------------- HELPERS -------------------------
+
+static uint64_t alignUp(uint64_t offset) {
+    /*
+       Rounds an offset up to the next multiple of 8.
+    */
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+static bool writePadding(FILE* fp, uint64_t* pos, uint64_t target) {
+    /*
+       Writes zero bytes until the file position reaches target.
+    */
+    static const char zeros[8] = {0};
+    while (*pos < target) {
+        size_t n = (size_t)(target - *pos) < sizeof(zeros) ? (size_t)(target - *pos) : sizeof(zeros);
+        if (fwrite(zeros, 1, n, fp) != n)
+            return false;
+        *pos += n;
+    }
+    return true;
+}
+
+static bool writeBlock(FILE* fp, uint64_t* pos, const void* data, size_t bytes) {
+    /*
+       Writes a block of bytes and advances the tracked file position.
+    */
+    if (bytes && fwrite(data, 1, bytes, fp) != bytes)
+        return false;
+    *pos += bytes;
+    return true;
+}
+
+// ------------------------- WRITER -------------------------
+
+bool writeTokenStream(TokenBuffer* tokens, const char* path) {
+    /*
+       Serializes the token buffer and its symbol table.
+       The stream is written to a temporary file first and renamed over
+       the target, so readers never observe a partially written stream.
+    */
+    if (!tokens || !path) {
+        fprintf(stderr, "Invalid arguments to writeTokenStream\n");
+        return false;
+    }
+
+    SymbolTable* table = tokens->symbols;
+    if (table->shared) {
+        fprintf(stderr, "Token streams need a per-file symbol table\n");
+        return false;
+    }
+    uint32_t symbolCount = (uint32_t) table->size;
+
+    // Lay out the sections
+    uint32_t stringBytes = 0;
+    for (uint32_t i = 0; i < symbolCount; i++)
+        stringBytes += table->entries[i]->length + 1;
+
+    TokenStreamHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TOKEN_STREAM_MAGIC, 4);
+    header.version = TOKEN_STREAM_VERSION;
+    header.headerSize = sizeof(TokenStreamHeader);
+    header.byteOrder = TOKEN_STREAM_BYTE_ORDER;
+    header.tokenCount = (uint32_t) tokens->count;
+    header.symbolCount = symbolCount;
+    header.stringBytes = stringBytes;
+    header.symbolsOffset = alignUp(sizeof(TokenStreamHeader));
+    header.stringsOffset = alignUp(header.symbolsOffset + (uint64_t) symbolCount * sizeof(TokenStreamSymbol));
+    header.kindOffset = alignUp(header.stringsOffset + stringBytes);
+    header.symbolIdOffset = alignUp(header.kindOffset + header.tokenCount);
+    header.lineOffset = alignUp(header.symbolIdOffset + (uint64_t) header.tokenCount * sizeof(uint32_t));
+
+    char tmpPath[4096];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+    FILE* fp = fopen(tmpPath, "wb");
+    if (!fp) {
+        fprintf(stderr, "Could not open %s for writing the token stream\n", tmpPath);
+        return false;
+    }
+
+    uint64_t pos = 0;
+    bool ok = writeBlock(fp, &pos, &header, sizeof(header));
+
+    // Symbol records, indexed by symbol id
+    ok = ok && writePadding(fp, &pos, header.symbolsOffset);
+    uint32_t stringOffset = 0;
+    for (uint32_t i = 0; ok && i < symbolCount; i++) {
+        SymbolTableEntry* entry = table->entries[i];
+        TokenStreamSymbol sym;
+        memset(&sym, 0, sizeof(sym));
+        sym.stringOffset = stringOffset;
+        sym.length = entry->length;
+        sym.kind = (uint8_t) entry->tokenType;
+        ok = writeBlock(fp, &pos, &sym, sizeof(sym));
+        stringOffset += entry->length + 1;
+    }
+
+    // String table
+    ok = ok && writePadding(fp, &pos, header.stringsOffset);
+    for (uint32_t i = 0; ok && i < symbolCount; i++)
+        ok = writeBlock(fp, &pos, table->entries[i]->lexeme, table->entries[i]->length + 1);
+
+    // Token columns
+    ok = ok && writePadding(fp, &pos, header.kindOffset);
+    ok = ok && writeBlock(fp, &pos, tokens->kind, header.tokenCount * sizeof(uint8_t));
+    ok = ok && writePadding(fp, &pos, header.symbolIdOffset);
+    ok = ok && writeBlock(fp, &pos, tokens->symbolId, header.tokenCount * sizeof(uint32_t));
+    ok = ok && writePadding(fp, &pos, header.lineOffset);
+    ok = ok && writeBlock(fp, &pos, tokens->lineNum, header.tokenCount * sizeof(uint32_t));
+
+    if (fclose(fp) != 0)
+        ok = false;
+    if (!ok || rename(tmpPath, path) != 0) {
+        fprintf(stderr, "Could not write the token stream to %s\n", path);
+        remove(tmpPath);
+        return false;
+    }
+    return true;
+}
+
+// ------------------------- READER -------------------------
+
+TokenBuffer* mapTokenStream(const char* path) {
+    /*
+       Maps the stream file privately and validates its header. The token
+       columns of the mapping become the arrays of the returned buffer; only
+       the symbol records are turned into symbol table entries.
+    */
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(TokenStreamHeader)) {
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t) st.st_size;
+    char* base = (char*) mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return NULL;
+
+    const TokenStreamHeader* header = (const TokenStreamHeader*) base;
+    bool valid = memcmp(header->magic, TOKEN_STREAM_MAGIC, 4) == 0
+        && header->version == TOKEN_STREAM_VERSION
+        && header->headerSize == sizeof(TokenStreamHeader)
+        && header->byteOrder == TOKEN_STREAM_BYTE_ORDER
+        && header->symbolsOffset + (uint64_t) header->symbolCount * sizeof(TokenStreamSymbol) <= size
+        && header->stringsOffset + header->stringBytes <= size
+        && header->kindOffset + header->tokenCount <= size
+        && header->symbolIdOffset + (uint64_t) header->tokenCount * sizeof(uint32_t) <= size
+        && header->lineOffset + (uint64_t) header->tokenCount * sizeof(uint32_t) <= size;
+    if (!valid) {
+        fprintf(stderr, "%s is not a compatible token stream\n", path);
+        munmap(base, size);
+        return NULL;
+    }
+
+    // Rebuild the symbol table; ids are assigned in record order
+    initTokenStrings();
+    SymbolTable* table = newSymbolTable();
+    const TokenStreamSymbol* syms = (const TokenStreamSymbol*)(base + header->symbolsOffset);
+    const char* strings = base + header->stringsOffset;
+    for (uint32_t i = 0; i < header->symbolCount; i++) {
+        // The lexeme and its terminator must lie in the string table
+        uint64_t end = (uint64_t) syms[i].stringOffset + syms[i].length;
+        if (end >= header->stringBytes || strings[end] != '\0' || syms[i].kind >= TK_NOT_FOUND) {
+            fprintf(stderr, "%s has a corrupt symbol record\n", path);
+            munmap(base, size);
+            return NULL;
+        }
+        SymbolTableEntry* entry = newSymbolTableEntry((char*)(strings + syms[i].stringOffset),
+                                                      (Token) syms[i].kind);
+        addToken(table, entry);
+    }
+
+    TokenBuffer* buf = (TokenBuffer*) calloc(1, sizeof(TokenBuffer));
+    if (!buf) {
+        fprintf(stderr, "Memory allocation failed for TokenBuffer\n");
+        munmap(base, size);
+        return NULL;
+    }
+    buf->count = (int) header->tokenCount;
+    buf->capacity = buf->count;
+    buf->symbols = table;
+    buf->kind = (uint8_t*)(base + header->kindOffset);
+    buf->symbolId = (uint32_t*)(base + header->symbolIdOffset);
+    buf->lineNum = (uint32_t*)(base + header->lineOffset);
+    buf->mappedBase = base;
+    buf->mappedSize = size;
+
+    // Every symbol id must refer to a record
+    for (int i = 0; i < buf->count; i++) {
+        if (buf->symbolId[i] >= header->symbolCount) {
+            fprintf(stderr, "%s has a token with an unknown symbol id\n", path);
+            freeTokenBuffer(buf);
+            return NULL;
+        }
+    }
+    return buf;
+}
@@ -0,0 +1,63 @@
+/*
+   ====================================================================
+   Binary Token Stream - Definitions and Function Prototypes
+   --------------------------------------------------------------------
+   A compact, versioned on-disk form of a TokenBuffer so that cached
+   sources can be parsed without lexing them again. Layout:
+
+     header | symbol records | string table | kinds | symbol ids | lines
+
+   Symbol records intern every lexeme once. Tokens are fixed-width
+   records (kind, symbol id, line) stored column by column, so that a
+   mapped file can be used as a TokenBuffer in place.
+   ====================================================================
+*/
+
+#ifndef TOKEN_STREAM_H
+#define TOKEN_STREAM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "lexerDef.h"
+
+/* Constant Definitions */
+#define TOKEN_STREAM_MAGIC       "TKST"      // First four bytes of every stream file
+#define TOKEN_STREAM_VERSION     2           // Bumped on every layout change
+#define TOKEN_STREAM_BYTE_ORDER  0x01020304  // Written natively to detect foreign byte order
+#define TOKEN_STREAM_EXT         ".tks"      // Extension of cached token streams
+
+// TokenStreamHeader: Fixed header at the start of the file.
+// All offsets are from the start of the file and 8-byte aligned.
+typedef struct TokenStreamHeader {
+    char magic[4];            // TOKEN_STREAM_MAGIC
+    uint16_t version;         // TOKEN_STREAM_VERSION
+    uint16_t headerSize;      // sizeof(TokenStreamHeader)
+    uint32_t byteOrder;       // TOKEN_STREAM_BYTE_ORDER
+    uint32_t tokenCount;      // Number of token records
+    uint32_t symbolCount;     // Number of symbol records
+    uint32_t stringBytes;     // Size of the string table
+    uint64_t symbolsOffset;   // Array of TokenStreamSymbol
+    uint64_t stringsOffset;   // Concatenated lexemes, each '\0' terminated
+    uint64_t kindOffset;      // uint8_t kind per token
+    uint64_t symbolIdOffset;  // uint32_t symbol id per token
+    uint64_t lineOffset;      // uint32_t line number per token
+} TokenStreamHeader;
+
+// TokenStreamSymbol: One interned lexeme, stored at the position of its symbol id.
+typedef struct TokenStreamSymbol {
+    uint32_t stringOffset;    // Offset of the lexeme in the string table
+    uint16_t length;          // Lexeme length
+    uint8_t kind;             // Token type
+    uint8_t reserved;         // Padding, written as zero
+} TokenStreamSymbol;
+
+/* ----------- Token Stream Functions ----------- */
+// Write the token buffer to the given path; the file is replaced atomically.
+bool writeTokenStream(TokenBuffer* tokens, const char* path);
+
+// Map a token stream file and expose it as a read-only token buffer.
+// Release it with freeTokenBuffer(); its symbols live in the compilation arena.
+TokenBuffer* mapTokenStream(const char* path);
+
+#endif